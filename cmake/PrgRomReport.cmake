@@ -0,0 +1,39 @@
+# Report the PRG ROM used by a linked NES program.
+#   MAP_FILE:  the lld map file of the link.
+#   PRG_START: the CPU address PRG ROM starts at.
+#   PRG_SIZE:  the bytes of PRG ROM.
+#   FREE_FILE: if set, the bytes left are written to it.
+#
+# An output section is in PRG ROM if it runs from there, or if it is loaded
+# from somewhere other than where it runs: the initial values of .data are
+# copied to RAM from ROM.  CHR ROM is a separate chip.
+
+file(STRINGS ${MAP_FILE} MAP_LINES REGEX "^ *[0-9a-f]+ +[0-9a-f]+ +[0-9a-f]+ +[0-9]+ [^ ]+$")
+
+set(PRG_USED 0)
+
+foreach (MAP_LINE IN LISTS MAP_LINES)
+  if (MAP_LINE MATCHES "^ *([0-9a-f]+) +([0-9a-f]+) +([0-9a-f]+) +[0-9]+ ([^ ]+)$")
+    math(EXPR SECTION_VMA "0x${CMAKE_MATCH_1}")
+    math(EXPR SECTION_SIZE "0x${CMAKE_MATCH_3}")
+    set(SECTION_NAME ${CMAKE_MATCH_4})
+
+    if (NOT SECTION_NAME STREQUAL ".chr_rom" AND SECTION_SIZE GREATER 0 AND
+        (SECTION_VMA GREATER_EQUAL PRG_START OR NOT CMAKE_MATCH_1 STREQUAL CMAKE_MATCH_2))
+      message(STATUS "PRG ROM: ${SECTION_NAME} ${SECTION_SIZE} bytes")
+      math(EXPR PRG_USED "${PRG_USED} + ${SECTION_SIZE}")
+    endif()
+  endif()
+endforeach()
+
+math(EXPR PRG_LEFT "${PRG_SIZE} - ${PRG_USED}")
+message(STATUS "PRG ROM: ${PRG_USED} bytes in use, ${PRG_LEFT} bytes left")
+
+if (PRG_LEFT LESS 0)
+  math(EXPR PRG_OVER "0 - (${PRG_LEFT})")
+  message(FATAL_ERROR "PRG ROM: ${PRG_OVER} bytes too many")
+endif()
+
+if (FREE_FILE)
+  file(WRITE ${FREE_FILE} "${PRG_LEFT}\n")
+endif()
@@ -0,0 +1,57 @@
+# Deal the seed bank with the seedbank tool.
+#   SEEDBANK:      the tool.
+#   OUTPUT:        the header to write.
+#   SEED:          the random seed the boards are dealt from.
+#   MAX_BOARDS:    the most boards kept per preset.
+#   PRESETS:       NAME ROWS COLUMNS MINES BUDGET of each preset, joined by ':'.
+#   FREE_FILE:     the PRG ROM left by a link with the bank of SIZING_HEADER,
+#   SIZING_HEADER: which has one board for each preset with a budget.
+#
+# A budget of 'rest' is what the sizing link left, plus what its bank took,
+# less the budgets of the other presets.
+
+cmake_minimum_required(VERSION 3.22.1)
+
+string(REPLACE ":" ";" PRESETS "${PRESETS}")
+
+if ("rest" IN_LIST PRESETS)
+  if (NOT FREE_FILE)
+    message(FATAL_ERROR "seed bank: a 'rest' budget needs a sizing link")
+  endif()
+
+  file(STRINGS ${FREE_FILE} PRG_FREE LIMIT_COUNT 1)
+
+  set(SIZING_BYTES 0)
+  file(STRINGS ${SIZING_HEADER} SIZING_LINES REGEX "^// [A-Z_]+: [0-9]+ boards, [0-9]+ bytes$")
+  foreach (SIZING_LINE IN LISTS SIZING_LINES)
+    if (SIZING_LINE MATCHES ", ([0-9]+) bytes$")
+      math(EXPR SIZING_BYTES "${SIZING_BYTES} + ${CMAKE_MATCH_1}")
+    endif()
+  endforeach()
+
+  set(FIXED_BYTES 0)
+  list(LENGTH PRESETS PRESET_FIELDS)
+  foreach (BUDGET_INDEX RANGE 4 ${PRESET_FIELDS} 5)
+    list(GET PRESETS ${BUDGET_INDEX} BUDGET)
+    if (NOT BUDGET STREQUAL "rest")
+      math(EXPR FIXED_BYTES "${FIXED_BYTES} + ${BUDGET}")
+    endif()
+  endforeach()
+
+  math(EXPR REST_BYTES "${PRG_FREE} + ${SIZING_BYTES} - ${FIXED_BYTES}")
+  message(STATUS "seed bank: ${PRG_FREE} bytes of PRG ROM left with ${SIZING_BYTES} "
+                 "bytes of boards, ${REST_BYTES} bytes for the 'rest' budget")
+  if (REST_BYTES LESS 0)
+    message(FATAL_ERROR "seed bank: the fixed budgets are over the PRG ROM left")
+  endif()
+
+  list(TRANSFORM PRESETS REPLACE "^rest$" ${REST_BYTES})
+endif()
+
+execute_process(
+  COMMAND ${SEEDBANK} ${OUTPUT} ${SEED} ${MAX_BOARDS} ${PRESETS}
+  RESULT_VARIABLE SEEDBANK_RESULT
+)
+if (SEEDBANK_RESULT)
+  message(FATAL_ERROR "seed bank: seedbank failed: ${SEEDBANK_RESULT}")
+endif()
@@ -0,0 +1,29 @@
+# Report the zero page used by the .zp output sections of a linked program.
+#   MAP_FILE: the lld map file of the link.
+#   ZP_END:   first address past the zero page the platform leaves to programs.
+
+file(STRINGS ${MAP_FILE} MAP_LINES REGEX "^ *[0-9a-f]+ +[0-9a-f]+ +[0-9a-f]+ +[0-9]+ \\.zp")
+
+set(ZP_USED 0)
+set(ZP_TOP 0)
+
+foreach (MAP_LINE IN LISTS MAP_LINES)
+  if (MAP_LINE MATCHES "^ *([0-9a-f]+) +[0-9a-f]+ +([0-9a-f]+) +[0-9]+ (\\.zp[^ ]*)$")
+    math(EXPR SECTION_START "0x${CMAKE_MATCH_1}")
+    math(EXPR SECTION_SIZE "0x${CMAKE_MATCH_2}")
+    math(EXPR SECTION_END "${SECTION_START} + ${SECTION_SIZE}")
+    message(STATUS "zero page: ${CMAKE_MATCH_3} ${SECTION_SIZE} bytes")
+
+    math(EXPR ZP_USED "${ZP_USED} + ${SECTION_SIZE}")
+    if (SECTION_END GREATER ZP_TOP)
+      set(ZP_TOP ${SECTION_END})
+    endif()
+  endif()
+endforeach()
+
+math(EXPR ZP_LEFT "${ZP_END} - ${ZP_TOP}")
+if (ZP_TOP EQUAL 0)
+  set(ZP_LEFT "all")
+endif()
+
+message(STATUS "zero page: ${ZP_USED} bytes in use, ${ZP_LEFT} bytes left")
@@ -0,0 +1,72 @@
+#pragma once
+
+#ifndef MINESWEEPER_LOOKUP_TABLES_H
+#define MINESWEEPER_LOOKUP_TABLES_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Small functions of a byte, worked out at compile time into ROM tables.
+// The 6502 has no barrel shifter, so a variable shift is a loop; one indexed
+// load from a table is cheaper than computing any of these at run time.
+namespace lut {
+
+template <class T, std::uint16_t len> struct Table {
+  T m_data[len];
+
+  constexpr T operator[](std::uint8_t index) const { return m_data[index]; }
+};
+
+// The table of function(i), for i in [0, len).
+template <class T, std::uint16_t len, class Function>
+constexpr Table<T, len> make_table(Function function) {
+  Table<T, len> table{};
+  for (std::uint16_t i = 0; i < len; i += 1) {
+    table.m_data[i] = function(static_cast<std::uint8_t>(i));
+  }
+  return table;
+}
+
+// For bit N of a little-endian multi-byte bitmap: the byte it is in, and
+// its mask within that byte.
+inline constexpr auto byte_index = make_table<std::uint8_t, 32>(
+    [](std::uint8_t bit) { return static_cast<std::uint8_t>(bit >> 3); });
+
+inline constexpr auto bit_mask = make_table<std::byte, 32>(
+    [](std::uint8_t bit) { return std::byte{1} << (bit & 0x7); });
+
+// The lowest bit set in a byte; 8 for none.
+inline constexpr auto lowest_bit = make_table<std::uint8_t, 256>(
+    [](std::uint8_t byte) {
+      std::uint8_t bit = 0;
+      while (bit < 8 && !(byte & (1u << bit))) {
+        bit += 1;
+      }
+      return bit;
+    });
+
+// The number of bits set in a byte.
+inline constexpr auto bit_count = make_table<std::uint8_t, 256>(
+    [](std::uint8_t byte) {
+      std::uint8_t count = 0;
+      for (; byte; byte &= byte - 1) {
+        count += 1;
+      }
+      return count;
+    });
+
+// For 2-bit fields packed 4 to a byte, such as NES attribute bytes: the
+// shift and the mask of field N.
+inline constexpr auto pair_shift = make_table<std::uint8_t, 4>(
+    [](std::uint8_t field) { return static_cast<std::uint8_t>(field << 1); });
+
+inline constexpr auto pair_mask = make_table<std::byte, 4>(
+    [](std::uint8_t field) { return std::byte{0b11} << (field << 1); });
+
+// The 8 neighbours of a tile, as offsets from it.
+inline constexpr std::int8_t neighbour_dx[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+inline constexpr std::int8_t neighbour_dy[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+
+} // namespace lut
+
+#endif
@@ -8,16 +8,54 @@
 #include "tile_model.h"
 #include "input_model.h"
 #include "algorithm_impl.h"
+#include "zero_page.h"
+#include "lookup_tables.h"
+#include "seed_bank.h"
 
 namespace {
 
 constexpr std::uint8_t ROWS_MAX = 16;
 constexpr std::uint8_t COLUMNS_MAX = 30;
 
-std::uint8_t game_rows = 0;
-std::uint8_t game_columns = 0;
+ZP_BSS std::uint8_t game_rows = 0;
+ZP_BSS std::uint8_t game_columns = 0;
 std::uint8_t mines = 0;
 
+struct DifficultySettings
+{
+  std::uint8_t m_rows;
+  std::uint8_t m_columns;
+  std::uint8_t m_mines;
+
+  constexpr DifficultySettings(std::uint8_t rows, std::uint8_t columns,
+                               std::uint8_t mines)
+      : m_rows{rows}, m_columns{columns}, m_mines{mines} {}
+};
+
+constexpr DifficultySettings DIFFICULTY_PRESETS[] = {
+    {9, 9, 10}, {16,16,40}, {16,30,99}
+};
+
+// the seed bank is generated at build time from its own copy of the presets.
+constexpr bool seed_bank_matches_presets() {
+  for (std::uint8_t i = 0; i < 3; i += 1) {
+    if (SEED_BANK_PRESETS[i][0] != DIFFICULTY_PRESETS[i].m_rows ||
+        SEED_BANK_PRESETS[i][1] != DIFFICULTY_PRESETS[i].m_columns ||
+        SEED_BANK_PRESETS[i][2] != DIFFICULTY_PRESETS[i].m_mines) {
+      return false;
+    }
+  }
+  return true;
+}
+static_assert(sizeof(SEED_BANK_PRESETS) == sizeof(DIFFICULTY_PRESETS) &&
+              seed_bank_matches_presets());
+
+// index into DIFFICULTY_PRESETS of the board being played.
+ZP_BSS std::uint8_t game_preset = 0;
+
+// only deal boards that can be solved from the first tile without guessing.
+bool no_guess = false;
+
 target::graphics::sprite cursor;
 std::uint8_t cursor_anim_frame = 0;
 
@@ -25,36 +63,6 @@ std::uint8_t cursor_anim_frame = 0;
   target::graphics::sprite sprite_background;
 #endif
 
-  struct OptionalTilePoint : public TilePoint {
-
-    OptionalTilePoint() = default;
-    OptionalTilePoint(TilePoint p) : TilePoint{p}, is_valid{true} {}
-
-    OptionalTilePoint left() const {
-      return is_valid && X > 0 ? OptionalTilePoint{TilePoint::left()}
-                               : OptionalTilePoint{};
-    }
-
-    OptionalTilePoint right() const {
-      return is_valid && X < (game_columns - 1)
-                 ? OptionalTilePoint{TilePoint::right()}
-                 : OptionalTilePoint{};
-    }
-
-    OptionalTilePoint up() const {
-      return is_valid && Y > 0 ? OptionalTilePoint{TilePoint::up()}
-                               : OptionalTilePoint{};
-    }
-
-    OptionalTilePoint down() const {
-      return is_valid && Y < (game_rows - 1)
-                 ? OptionalTilePoint{TilePoint::down()}
-                 : OptionalTilePoint{};
-    }
-
-    bool is_valid = false;
-  };
-
   template <bool immediate> struct PlaceTile;
 
   template <> struct PlaceTile<true> {
@@ -73,6 +81,10 @@ std::uint8_t cursor_anim_frame = 0;
   {
     using Traits = target::graphics;
     using TileType = Traits::tile_type;
+    using Digit = std::decay_t<decltype(Traits::ScoreDigits[0])>;
+
+    // DrawRate()'s width: a digit, the gap and two digits.
+    static constexpr std::uint8_t RateWidth = 4;
 
     template <class LeftCornerType, class MiddleType, class RightCornerType>
     static void DrawBorderRow(std::uint8_t currentRow,
@@ -168,9 +180,7 @@ std::uint8_t cursor_anim_frame = 0;
   public:
 
     template<bool immediate>
-    static void Draw000(std::uint8_t x_off, std::uint16_t val) {
-      const std::uint8_t y_pos = board_pos.Y + TopBorderHeight;
-
+    static void Draw000(std::uint8_t x_off, std::uint8_t y_pos, std::uint16_t val) {
       if (immediate) {
         for (std::uint8_t i = 3; i < Traits::ScoreSize; i += 1) {
           DrawTile<true>(Traits::ScoreDigits[0], x_off++, y_pos);
@@ -187,6 +197,29 @@ std::uint8_t cursor_anim_frame = 0;
       DrawTile<immediate>(Traits::ScoreDigits[val], x_off++, y_pos);
     }
 
+    // 'hundredths' as a digit, a gap for the decimal point there is no
+    // tile for, and two more digits: "1 25" for 1.25.
+    template<bool immediate>
+    static void DrawRate(std::uint8_t x_off, std::uint8_t y_pos, std::uint16_t hundredths) {
+      DrawTile<immediate>(Traits::ScoreDigits[hundredths / 100], x_off, y_pos);
+      if (immediate) {
+        for (std::uint8_t i = 0; i < Height<Digit>::value; i += 1) {
+          DrawTile<true>(Traits::BLANK, x_off + 1, y_pos + i);
+        }
+      }
+      hundredths %= 100;
+      DrawTile<immediate>(Traits::ScoreDigits[hundredths / 10], x_off + 2, y_pos);
+      DrawTile<immediate>(Traits::ScoreDigits[hundredths % 10], x_off + 3, y_pos);
+    }
+
+    // screen address of the first tile of each board row, for the current
+    // layout; filled by SetGameSize().
+    static Traits::tile_address row_address[ROWS_MAX];
+
+    static Traits::tile_address SelectionToAddress(const TilePoint & game_selection) {
+      return row_address[game_selection.Y] + game_selection.X;
+    }
+
     static TilePoint SelectionToTilePosition(const TilePoint & game_selection) {
       return {static_cast<std::uint8_t>(board_pos.X + LeftBorderWidth + pad_left +
                                         game_selection.X),
@@ -198,6 +231,11 @@ std::uint8_t cursor_anim_frame = 0;
       game_rows = rows;
       game_columns = columns;
       CenterBoardOnScreen();
+
+      for (std::uint8_t y = 0; y < game_rows; y += 1) {
+        const auto first = SelectionToTilePosition(TilePoint{0, y});
+        row_address[y] = Traits::address_of(first.X, first.Y);
+      }
     }
 
     static constexpr std::uint8_t TopBorderHeight =
@@ -210,6 +248,11 @@ std::uint8_t cursor_anim_frame = 0;
     static_assert(Traits::ScoreSize >= 3);
 
     static void DrawBoard() {
+      // not GenerateTileString(): its return type is not deduced yet here.
+      static constexpr auto BBBV_LABEL =
+          transform_string<Traits::chr_code_type, Traits::tile_to_char>("3BV");
+      static constexpr auto BBBV_RATE_LABEL =
+          transform_string<Traits::chr_code_type, Traits::tile_to_char>("3BV S");
       static std::uint8_t currentRow;
 
       currentRow = board_pos.Y;
@@ -240,15 +283,34 @@ std::uint8_t cursor_anim_frame = 0;
 
       DrawResetButtonHappy();
 
-      Draw000<true>(board_pos.X + LeftBorderWidth, 0);
-      Draw000<true>(board_pos.X + LeftBorderWidth + game_width - Traits::ScoreSize, 0);
+      Draw000<true>(board_pos.X + LeftBorderWidth, score_y(), 0);
+      Draw000<true>(board_pos.X + LeftBorderWidth + game_width - Traits::ScoreSize, score_y(), 0);
+
+      Draw000<true>(board_pos.X + LeftBorderWidth, stats_y(), 0);
+      DrawRate<true>(board_pos.X + LeftBorderWidth + game_width - RateWidth, stats_y(), 0);
+      DrawString(BBBV_LABEL, board_pos.X + LeftBorderWidth,
+                 stats_y() + Height<Digit>::value);
+      DrawString(BBBV_RATE_LABEL,
+                 board_pos.X + LeftBorderWidth + game_width -
+                     sizeof(BBBV_RATE_LABEL.m_data),
+                 stats_y() + Height<Digit>::value);
     }
 
     static void DrawScore(std::uint8_t score) {
-      Draw000<false>(board_pos.X + LeftBorderWidth, score);
+      Draw000<false>(board_pos.X + LeftBorderWidth, score_y(), score);
     }
     static void DrawTime(std::uint16_t seconds) {
-      Draw000<false>(board_pos.X + LeftBorderWidth + game_width - Traits::ScoreSize, seconds);
+      Draw000<false>(board_pos.X + LeftBorderWidth + game_width - Traits::ScoreSize, score_y(), seconds);
+    }
+
+    // The tiles DrawStats() places.
+    static constexpr std::uint8_t StatsTiles = 6 * Height<Digit>::value;
+
+    // Fill in the 3BV counters under the board, drawn as zeros with the rest
+    // of the board: the board's 3BV, and 3BV/s in hundredths.
+    static void DrawStats(std::uint16_t bbbv, std::uint16_t hundredths) {
+      Draw000<false>(board_pos.X + LeftBorderWidth, stats_y(), bbbv);
+      DrawRate<false>(board_pos.X + LeftBorderWidth + game_width - RateWidth, stats_y(), hundredths);
     }
 
     static void DrawResetButtonHappy() {
@@ -269,27 +331,27 @@ std::uint8_t cursor_anim_frame = 0;
 
     static void Mine(const TilePoint & tile)
     {
-      Traits::place(Traits::Mine, SelectionToTilePosition(tile));
+      Traits::place(Traits::Mine, SelectionToAddress(tile));
     }
 
     static void Wrong(const TilePoint & tile) {
-      Traits::place(Traits::Wrong, SelectionToTilePosition(tile));
+      Traits::place(Traits::Wrong, SelectionToAddress(tile));
     }
 
     static void Flag(const TilePoint & tile)
     {
-      Traits::place(Traits::Flag, SelectionToTilePosition(tile));
+      Traits::place(Traits::Flag, SelectionToAddress(tile));
     }
 
     static void Hide(const TilePoint & tile)
     {
-      Traits::place(Traits::HiddenSquare, SelectionToTilePosition(tile));
+      Traits::place(Traits::HiddenSquare, SelectionToAddress(tile));
     }
 
     static std::uint8_t ShowCount(std::uint8_t count, const TilePoint & where)
     {
       Traits::place(Traits::NumberMarker(count),
-                    SelectionToTilePosition(where));
+                    SelectionToAddress(where));
       return count;
     }
 
@@ -326,9 +388,21 @@ std::uint8_t cursor_anim_frame = 0;
     }
 
     static std::uint8_t reset_button_y() {
+      return score_y();
+    }
+
+    static std::uint8_t score_y() {
       return board_pos.Y + TopBorderHeight;
     }
 
+    // the top row of the 3BV counters, just under the bottom border; on the
+    // NES it starts an attribute block, so the digits get their palette.
+    static std::uint8_t stats_y() {
+      const std::uint8_t y = board_pos.Y + TopBorderHeight + Traits::ScoreRows +
+                             game_height + BottomBorderHeight;
+      return Traits::GameBoardHeightMustBeEven ? y + (y & 0b1) : y;
+    }
+
     template <std::uint8_t len>
     static void
     DrawString(const TilePattern<Traits::chr_code_type, len> &pattern,
@@ -343,122 +417,843 @@ std::uint8_t cursor_anim_frame = 0;
   };
 
   TilePoint GameBoardDraw::board_pos{0, 0};
+  GameBoardDraw::Traits::tile_address GameBoardDraw::row_address[ROWS_MAX];
   std::uint8_t GameBoardDraw::game_width = 0; // internal width of game board, including padding;
   std::uint8_t GameBoardDraw::game_height = 0; // internal height of game board, including padding;
   std::uint8_t GameBoardDraw::pad_left = 0;  // left side padding (blank space between border and game)
   std::uint8_t GameBoardDraw::pad_right = 0;
   std::uint8_t GameBoardDraw::pad_bottom = 0;
 
+  // One board row of bits.  Column X lives in bit X + GUARD, leaving a guard
+  // bit on either side of the board, so the 3 tiles around any column can be
+  // read without checking for the edges.
   struct RowBits {
-    std::byte m_bits[(COLUMNS_MAX >> 3) + static_cast<bool>(COLUMNS_MAX & 0x7)];
+    static constexpr std::uint8_t GUARD = 1;
+    static constexpr std::uint8_t PADDED_COLUMNS = COLUMNS_MAX + 2 * GUARD;
+
+    std::byte m_bits[(PADDED_COLUMNS >> 3) + static_cast<bool>(PADDED_COLUMNS & 0x7)];
 
     bool test(std::uint8_t position_x) const {
-      const auto byte = m_bits[position_x >> 3];
-      return (byte & (std::byte{1} << (position_x & 0x7))) != std::byte{0};
+      const std::uint8_t bit = position_x + GUARD;
+      return (m_bits[lut::byte_index[bit]] & lut::bit_mask[bit]) != std::byte{0};
     }
 
     bool set(std::uint8_t position_x, bool value = true) {
-      const std::byte set_pattern = std::byte{1} << (position_x & 0x7);
+      const std::uint8_t bit = position_x + GUARD;
+      const std::byte set_pattern = lut::bit_mask[bit];
       if (value) {
-        m_bits[position_x >> 3] |= set_pattern;
+        m_bits[lut::byte_index[bit]] |= set_pattern;
       } else {
-        m_bits[position_x >> 3] &= ~(set_pattern);
+        m_bits[lut::byte_index[bit]] &= ~(set_pattern);
       }
 
       return value;
     }
+
+    // the tiles at columns X - 1, X and X + 1, in bits 0, 1 and 2.
+    std::uint8_t around(std::uint8_t position_x) const {
+      // column X - 1 is bit X, as the guard bit shifts every column up one.
+      std::uint8_t result = 0;
+      for (std::uint8_t i = 0; i < 3; i += 1) {
+        const std::uint8_t bit = position_x + i;
+        if ((m_bits[lut::byte_index[bit]] & lut::bit_mask[bit]) != std::byte{0}) {
+          result |= 1 << i;
+        }
+      }
+      return result;
+    }
+
+    // bits 'bit' to 'bit' + 8 of the row, in the low bits, from the two
+    // bytes they are in: a shift of at most 7, never one across the whole
+    // word.  Bits past the row read as 0.
+    std::uint16_t slice(std::uint8_t bit) const {
+      const std::uint8_t index = lut::byte_index[bit];
+      std::uint16_t bytes = std::to_integer<std::uint8_t>(m_bits[index]);
+      if (index < sizeof(m_bits) - 1) {
+        bytes |= std::to_integer<std::uint16_t>(m_bits[index + 1]) << 8;
+      }
+      return bytes >> (bit & 0x7);
+    }
+
+    // sets the bits of 'bits' from bit 'bit' of the row up; bits past the
+    // row are dropped.  At most 9 bits.
+    void set_slice(std::uint8_t bit, std::uint16_t bits) {
+      const std::uint8_t index = lut::byte_index[bit];
+      bits <<= bit & 0x7;
+      m_bits[index] |= static_cast<std::byte>(bits);
+      if (index < sizeof(m_bits) - 1) {
+        m_bits[index + 1] |= static_cast<std::byte>(bits >> 8);
+      }
+    }
+
+    // whole-row access, for the bit-parallel passes. bit N + GUARD is
+    // column N.
+    std::uint32_t word() const {
+      std::uint32_t result;
+      memcpy(&result, m_bits, sizeof(result));
+      return result;
+    }
+
+    void set_word(std::uint32_t value) {
+      memcpy(m_bits, &value, sizeof(value));
+    }
+  };
+
+  static_assert(sizeof(RowBits) == sizeof(std::uint32_t));
+
+  // the bits of a RowBits word that are columns on the current board.
+  std::uint32_t columns_mask() {
+    return ((std::uint32_t{1} << game_columns) - 1) << RowBits::GUARD;
+  }
+
+  // A difficulty preset's board as compile-time constants.  The board-wide
+  // passes are instantiated once per preset, so their loop bounds, masks and
+  // modulos are immediates instead of loads of game_rows/game_columns.
+  template <std::uint8_t Preset> struct BoardGeometry {
+    static constexpr std::uint8_t rows = DIFFICULTY_PRESETS[Preset].m_rows;
+    static constexpr std::uint8_t columns = DIFFICULTY_PRESETS[Preset].m_columns;
+    static constexpr std::uint32_t columns_mask =
+        ((std::uint32_t{1} << columns) - 1) << RowBits::GUARD;
   };
 
-  struct ExposeResultContinuation;
-  struct GameState {
-    using BitVector = RowBits[ROWS_MAX];
+  // Run 'pass(geometry)' with the BoardGeometry of the preset being played.
+  template <class Pass> void with_game_geometry(Pass pass) {
+    static_assert(sizeof(DIFFICULTY_PRESETS) / sizeof(DIFFICULTY_PRESETS[0]) == 3);
+
+    switch (game_preset) {
+    case 0:
+      pass(BoardGeometry<0>{});
+      break;
+    case 1:
+      pass(BoardGeometry<1>{});
+      break;
+    default:
+      pass(BoardGeometry<2>{});
+      break;
+    }
+  }
+
+  // The rows of a board, with a guard row above and below it, so the rows
+  // around any board row can be read without checking for the edges.  Row
+  // indexes wrap as uint8_t, which makes row -1 the top guard.
+  struct BoardBits {
+    RowBits m_rows[ROWS_MAX + 2];
+
+    RowBits & operator[](std::uint8_t y) {
+      return m_rows[static_cast<std::uint8_t>(y + 1)];
+    }
+
+    const RowBits & operator[](std::uint8_t y) const {
+      return m_rows[static_cast<std::uint8_t>(y + 1)];
+    }
+  };
+
+  // The neighbour counts of a whole row, bit-sliced: bit N of ones, twos,
+  // fours and eights together make the count for bit N of a RowBits word.
+  struct RowCounts {
+    std::uint32_t ones = 0;
+    std::uint32_t twos = 0;
+    std::uint32_t fours = 0;
+    std::uint32_t eights = 0;
+
+    // add 1 to the count of every bit set in 'lanes', rippling the carries.
+    void add(std::uint32_t lanes) {
+      const std::uint32_t carry_ones = ones & lanes;
+      ones ^= lanes;
+      const std::uint32_t carry_twos = twos & carry_ones;
+      twos ^= carry_ones;
+      const std::uint32_t carry_fours = fours & carry_twos;
+      fours ^= carry_twos;
+      eights |= carry_fours;
+    }
+
+    std::uint32_t zeros() const { return ~(ones | twos | fours | eights); }
+
+    // the count in bit 0, shifting the next bit's count down into its place.
+    std::uint8_t pop() {
+      const std::uint8_t count =
+          (static_cast<std::uint8_t>(ones) & 1) |
+          ((static_cast<std::uint8_t>(twos) & 1) << 1) |
+          ((static_cast<std::uint8_t>(fours) & 1) << 2) |
+          ((static_cast<std::uint8_t>(eights) & 1) << 3);
+      ones >>= 1;
+      twos >>= 1;
+      fours >>= 1;
+      eights >>= 1;
+      return count;
+    }
+  };
+
+  // Count, for every tile of row 'y' at once, how many of its 8 neighbours
+  // are set in 'bits'.  The guard rows make the rows above and below safe
+  // to read; the counts in the guard columns are meaningless.
+  RowCounts count_row(const BoardBits & bits, std::uint8_t y) {
+    const std::uint32_t above = bits[y - 1].word();
+    const std::uint32_t row = bits[y].word();
+    const std::uint32_t below = bits[y + 1].word();
+
+    RowCounts counts;
+    counts.add(above << 1);
+    counts.add(above);
+    counts.add(above >> 1);
+    counts.add(row << 1);
+    counts.add(row >> 1);
+    counts.add(below << 1);
+    counts.add(below);
+    counts.add(below >> 1);
+    return counts;
+  }
+
+  // One 4-bit counter per tile; enough for the 0-8 neighbouring mines.
+  struct RowNibbles {
+    std::uint8_t m_nibbles[(COLUMNS_MAX >> 1) + static_cast<bool>(COLUMNS_MAX & 0x1)];
+
+    std::uint8_t get(std::uint8_t position_x) const {
+      const auto byte = m_nibbles[position_x >> 1];
+      return (position_x & 0x1) ? (byte >> 4) : (byte & 0xF);
+    }
+
+    // add +1 or -1; the counter must not wrap.
+    void add(std::uint8_t position_x, std::int8_t delta) {
+      m_nibbles[position_x >> 1] +=
+          static_cast<std::uint8_t>((position_x & 0x1) ? delta * 16 : delta);
+    }
+
+    void set(std::uint8_t position_x, std::uint8_t value) {
+      auto & byte = m_nibbles[position_x >> 1];
+      byte = (position_x & 0x1) ? (byte & 0x0F) | (value << 4)
+                                : (byte & 0xF0) | value;
+    }
+  };
+
+  // A long operation that is sliced across frames.  Each kind of job keeps
+  // its progress in plain state of its own (e.g. the reveal frontier), and
+  // resume() runs the next slice of the current job from a switch on its
+  // kind.  That avoids virtual calls, which need a stack on the
+  // NES, and means a new multi-frame job is just a new Kind and a case.
+  struct Job {
+    enum Kind : std::uint8_t {
+      NONE,
+      REVEAL, // stream the pending opening in the expose frontier.
+      GAME_OVER_SWEEP, // show every mine and wrong flag after losing.
+      WIN_SWEEP, // flag every mine left hidden after winning.
+      UNDO, // take back the moves asked for from the journal.
+      GENERATE, // search for a board that needs no guessing.
+    };
+
+    enum Status : std::uint8_t {
+      DONE,   // finished in this slice.
+      YIELD,  // out of time for this frame, resume next frame.
+      FAILED, // finished, and lost the game.
+    };
+
+    void start(Kind next) { kind = next; }
+    bool running() const { return kind != NONE; }
+
+    Status resume();
+
+    Kind kind = NONE;
+  };
+
+  // The exposed and flag changes of the last few moves, so they can be undone
+  // without keeping copies of the board.  An entry is a tile index,
+  // (Y << 5) | X, with a kind and a span length; the tiles a move reveals
+  // next to each other on a row share one REVEAL entry.  The ring only keeps
+  // whole moves: when it fills up the oldest move is dropped, and a move too
+  // big for the ring on its own is not kept at all.
+  class Journal {
+  public:
+    enum Kind : std::uint8_t {
+      MOVE,   // starts the entries of a move.
+      FLAG,   // the tile's flag was toggled.
+      REVEAL, // a span of tiles was exposed.
+    };
+
+    void clear() {
+      m_end = 0;
+      m_size = 0;
+      m_moves = 0;
+      m_undos = 0;
+      m_new_move = false;
+      m_recording = false;
+    }
+
+    // the next change recorded starts a new move.
+    void begin_move() {
+      m_new_move = true;
+      m_recording = true;
+      m_undos = 0;
+    }
+
+    void flag(const TilePoint & tile) { record(FLAG, tile); }
+
+    void reveal(const TilePoint & tile) {
+      if (m_recording && !m_new_move && m_size != 0) {
+        auto & last = newest();
+        if (kind(last) == REVEAL && span(last) < SPAN_MAX &&
+            index(last) + span(last) == index_of(tile)) {
+          last += SPAN_ONE;
+          return;
+        }
+      }
+
+      record(REVEAL, tile);
+    }
+
+    // ask for one more move to be undone; false if every move kept already is.
+    bool request_undo() {
+      if (m_undos == m_moves) {
+        return false;
+      }
+      m_undos += 1;
+      return true;
+    }
+
+    bool undoing() const { return m_undos != 0; }
+
+    Kind newest_kind() const { return kind(newest()); }
+
+    // the newest tile of the newest entry.
+    TilePoint newest_tile() const {
+      const std::uint16_t tile = index(newest()) + span(newest()) - 1;
+      return TilePoint{static_cast<std::uint8_t>(tile & 0x1F),
+                       static_cast<std::uint8_t>(tile >> 5)};
+    }
+
+    // forget newest_tile(), once it has been undone.
+    void drop_newest_tile() {
+      auto & last = newest();
+      if (span(last) > 1) {
+        last -= SPAN_ONE;
+        return;
+      }
+
+      if (kind(last) == MOVE) {
+        m_moves -= 1;
+        m_undos -= 1;
+      }
+      m_end = (m_end - 1) & MASK;
+      m_size -= 1;
+    }
+
+  private:
+    // 64 entries of 2 bytes: enough for a couple of big openings.
+    static constexpr std::uint8_t SIZE = 64;
+    static constexpr std::uint8_t MASK = SIZE - 1;
+
+    // entry bits: 0-8 tile index, 9-10 kind, 11-15 span length - 1.
+    static constexpr std::uint8_t KIND_SHIFT = 9;
+    static constexpr std::uint8_t SPAN_SHIFT = 11;
+    static constexpr std::uint16_t SPAN_ONE = 1u << SPAN_SHIFT;
+    static constexpr std::uint8_t SPAN_MAX = 32;
+
+    static std::uint16_t index_of(const TilePoint & tile) {
+      return (std::uint16_t{tile.Y} << 5) | tile.X;
+    }
+    static std::uint16_t index(std::uint16_t entry) { return entry & 0x1FF; }
+    static Kind kind(std::uint16_t entry) {
+      return static_cast<Kind>((entry >> KIND_SHIFT) & 0x3);
+    }
+    static std::uint8_t span(std::uint16_t entry) {
+      return (entry >> SPAN_SHIFT) + 1;
+    }
+
+    std::uint16_t & newest() { return m_entries[(m_end - 1) & MASK]; }
+    const std::uint16_t & newest() const { return m_entries[(m_end - 1) & MASK]; }
+    const std::uint16_t & oldest() const {
+      return m_entries[(m_end - m_size) & MASK];
+    }
+
+    void record(Kind kind, const TilePoint & tile) {
+      if (m_new_move && m_recording) {
+        m_new_move = false;
+        m_moves += 1;
+        push(static_cast<std::uint16_t>(MOVE << KIND_SHIFT));
+      }
+      push(index_of(tile) | static_cast<std::uint16_t>(kind << KIND_SHIFT));
+    }
+
+    void push(std::uint16_t entry) {
+      if (!m_recording) {
+        return;
+      }
+
+      if (m_size == SIZE) {
+        drop_oldest_move();
+        if (!m_recording) {
+          return;
+        }
+      }
+
+      m_entries[m_end] = entry;
+      m_end = (m_end + 1) & MASK;
+      m_size += 1;
+    }
+
+    void drop_oldest_move() {
+      if (m_moves == 1) {
+        // the move being recorded filled the ring by itself.
+        clear();
+        m_recording = false;
+        return;
+      }
+
+      // the oldest entry is always a MOVE; drop it and the rest of its move.
+      do {
+        m_size -= 1;
+      } while (kind(oldest()) != MOVE);
+      m_moves -= 1;
+      m_undos -= m_undos > m_moves;
+    }
+
+    std::uint16_t m_entries[SIZE];
+    std::uint8_t m_end;   // where the next entry goes.
+    std::uint8_t m_size;  // entries kept.
+    std::uint8_t m_moves; // MOVE entries kept.
+    std::uint8_t m_undos; // moves still to undo.
+    bool m_new_move;
+    bool m_recording;     // false outside a move, or in one that overflowed.
+  };
+
+  // The bitplanes every storage layout keeps: the frontier, chord and sweeps
+  // work on whole row words.  mine_bits and flag_bits are clear on the guard
+  // border; exposed_bits is set there, so nothing off the board is ever
+  // hidden.
+  struct TilePlanes {
+    using BitVector = BoardBits;
     BitVector mine_bits;
     BitVector exposed_bits;
     BitVector flag_bits;
-    std::uint8_t mines_left;
-    std::uint16_t hidden_clear;
-    bool time_running;
-    std::uint16_t timer;
-    const ExposeResultContinuation *expose_continuation;
 
     static std::uint8_t count_bits(const BitVector & state_bits, const TilePoint & selection)
     {
       return state_bits[selection.Y].test(selection.X);
     }
 
-    static std::uint8_t count_bits(const BitVector &state_bits,
-                                   const OptionalTilePoint & selection) {
-      if (!selection.is_valid) {
-        return 0;
+    void put_mine(const TilePoint & tile) { mine_bits[tile.Y].set(tile.X); }
+    void put_exposed(const TilePoint & tile, bool value) {
+      exposed_bits[tile.Y].set(tile.X, value);
+    }
+    void put_flag(const TilePoint & tile, bool value) {
+      flag_bits[tile.Y].set(tile.X, value);
+    }
+
+    void clear() {
+      memset(&mine_bits, 0, sizeof(mine_bits));
+      memset(&exposed_bits, 0xFF, sizeof(exposed_bits));
+      for (std::uint8_t y = 0; y < game_rows; y += 1) {
+        exposed_bits[y].set_word(~columns_mask());
       }
+      memset(&flag_bits, 0, sizeof(flag_bits));
+    }
+  };
 
-      return state_bits[selection.Y].test(selection.X);
+  // Per-tile state read straight from the bitplanes, plus a nibble per tile
+  // for each of the neighbouring mine and flag counts.  Smallest in RAM, but
+  // every query is a shift and mask.
+  struct PackedTiles : TilePlanes {
+    RowNibbles mine_counts[ROWS_MAX];
+    RowNibbles flag_counts[ROWS_MAX];
+
+    bool mine_at(const TilePoint & tile) const { return count_bits(mine_bits, tile); }
+    bool exposed_at(const TilePoint & tile) const { return count_bits(exposed_bits, tile); }
+    bool flag_at(const TilePoint & tile) const { return count_bits(flag_bits, tile); }
+    std::uint8_t count_at(const TilePoint & tile) const {
+      return mine_counts[tile.Y].get(tile.X);
+    }
+
+    std::uint8_t flags_around_at(const TilePoint & tile) const {
+      return flag_counts[tile.Y].get(tile.X);
+    }
+
+    void put_count(const TilePoint & tile, std::uint8_t count) {
+      mine_counts[tile.Y].set(tile.X, count);
+    }
+
+    void add_flags_around(const TilePoint & tile, std::int8_t delta) {
+      flag_counts[tile.Y].add(tile.X, delta);
+    }
+
+    void clear() {
+      TilePlanes::clear();
+      memset(mine_counts, 0, sizeof(mine_counts));
+      memset(flag_counts, 0, sizeof(flag_counts));
+    }
+  };
+
+  // The bitplanes mirrored into one byte per tile, holding its mine, exposed
+  // and flag bits and its neighbouring mine count, so that every query is a
+  // single load.  The neighbouring flag count gets a byte of its own.  Costs
+  // two bytes per tile on top of the planes.
+  struct ByteTiles : TilePlanes {
+    enum : std::uint8_t {
+      COUNT = 0x0F,
+      MINE = 0x10,
+      EXPOSED = 0x20,
+      FLAG = 0x40,
+    };
+
+    std::uint8_t m_tiles[ROWS_MAX][COLUMNS_MAX];
+    std::uint8_t m_flags_around[ROWS_MAX][COLUMNS_MAX];
+
+    bool mine_at(const TilePoint & tile) const { return m_tiles[tile.Y][tile.X] & MINE; }
+    bool exposed_at(const TilePoint & tile) const { return m_tiles[tile.Y][tile.X] & EXPOSED; }
+    bool flag_at(const TilePoint & tile) const { return m_tiles[tile.Y][tile.X] & FLAG; }
+    std::uint8_t count_at(const TilePoint & tile) const {
+      return m_tiles[tile.Y][tile.X] & COUNT;
+    }
+
+    void put_mine(const TilePoint & tile) {
+      TilePlanes::put_mine(tile);
+      m_tiles[tile.Y][tile.X] |= MINE;
+    }
+
+    void put_exposed(const TilePoint & tile, bool value) {
+      TilePlanes::put_exposed(tile, value);
+      auto & byte = m_tiles[tile.Y][tile.X];
+      byte = value ? (byte | EXPOSED) : (byte & ~EXPOSED);
+    }
+
+    void put_flag(const TilePoint & tile, bool value) {
+      TilePlanes::put_flag(tile, value);
+      auto & byte = m_tiles[tile.Y][tile.X];
+      byte = value ? (byte | FLAG) : (byte & ~FLAG);
+    }
+
+    std::uint8_t flags_around_at(const TilePoint & tile) const {
+      return m_flags_around[tile.Y][tile.X];
+    }
+
+    void put_count(const TilePoint & tile, std::uint8_t count) {
+      auto & byte = m_tiles[tile.Y][tile.X];
+      byte = (byte & ~COUNT) | count;
+    }
+
+    void add_flags_around(const TilePoint & tile, std::int8_t delta) {
+      m_flags_around[tile.Y][tile.X] += delta;
+    }
+
+    void clear() {
+      TilePlanes::clear();
+      memset(m_tiles, 0, sizeof(m_tiles));
+      memset(m_flags_around, 0, sizeof(m_flags_around));
     }
+  };
+
+  template <class Tiles> struct BasicGameState : Tiles {
+    using typename Tiles::BitVector;
+    using Tiles::count_bits;
+    using Tiles::mine_bits;
+    using Tiles::flag_bits;
+
+    // tiles waiting in the expose frontier; never overlaps exposed_bits.
+    BitVector queued_bits;
+    // non-mine tiles with no neighbouring mines, filled by count_all_mines().
+    BitVector zero_bits;
+    // false until the first tile is opened; see generate_board().
+    bool mines_placed;
+    // the board's 3BV, from count_bbbv().
+    std::uint16_t bbbv;
+    std::uint8_t mines_left;
+    std::uint16_t hidden_clear;
+    bool time_running;
+    std::uint16_t timer;
+    Job job;
+    Journal journal;
 
     std::uint8_t count_mine(const TilePoint & selection) const {
-      return count_bits(mine_bits, selection);
+      return this->mine_at(selection);
     }
 
     bool exposed_test_and_set(const TilePoint & selection) {
-      auto & rowbits = exposed_bits[selection.Y];
-      if (rowbits.test(selection.X)) {
+      if (this->exposed_at(selection)) {
         return true;
       }
-      
-      rowbits.set(selection.X);
-      
+
+      this->put_exposed(selection, true);
+      journal.reveal(selection);
+
       return false;
     }
 
-    static std::uint8_t count_around(const BitVector & state_bits, const OptionalTilePoint & selection) {
-      const auto tile_up = selection.up();
-      const auto tile_down = selection.down();
-      return count_bits(state_bits, tile_up) +
-             count_bits(state_bits, tile_up.left()) +
-             count_bits(state_bits, tile_up.right()) +
-             count_bits(state_bits, selection.left()) +
-             count_bits(state_bits, selection.right()) +
-             count_bits(state_bits, tile_down) +
-             count_bits(state_bits, tile_down.left()) +
-             count_bits(state_bits, tile_down.right());
+    std::uint8_t count_mines_around(const TilePoint & selection) const {
+      return this->count_at(selection);
+    }
+
+    // Lay 'mines' mines uniformly at random, outside the 3x3 around 'safe',
+    // by Floyd's sampling: a partial Fisher-Yates shuffle over the cell
+    // indexes whose permutation is kept in mine_bits itself.  Every mine
+    // takes exactly one random number and no retries, however dense the
+    // board.
+    template <class Geometry>
+    void place_mines(Geometry, const TilePoint & safe) {
+      constexpr std::uint16_t cells =
+          std::uint16_t{Geometry::rows} * Geometry::columns;
+
+      // cell indexes are row-major.  Dividing by repeated subtraction takes
+      // at most ROWS_MAX steps, which beats a division loop on the 6502.
+      constexpr auto tile_of = [](std::uint16_t index) {
+        TilePoint tile{0, 0};
+        for (; index >= Geometry::columns; index -= Geometry::columns) {
+          tile.Y += 1;
+        }
+        tile.X = static_cast<std::uint8_t>(index);
+        return tile;
+      };
+      constexpr auto next = [](TilePoint & tile) {
+        if (++tile.X == Geometry::columns) {
+          tile.X = 0;
+          tile.Y += 1;
+        }
+      };
+      const auto is_safe = [&safe](const TilePoint & tile) {
+        return static_cast<std::uint8_t>(tile.X - safe.X + 1) < 3 &&
+               static_cast<std::uint8_t>(tile.Y - safe.Y + 1) < 3;
+      };
+
+      // mines are sampled from the first 'candidates' indexes, with each
+      // safe cell among them traded for one of the unsafe cells past them.
+      const std::uint8_t safe_columns =
+          1 + (safe.X > 0) + (safe.X < Geometry::columns - 1);
+      const std::uint8_t safe_rows =
+          1 + (safe.Y > 0) + (safe.Y < Geometry::rows - 1);
+      const std::uint16_t candidates = cells - safe_columns * safe_rows;
+      const TilePoint first_spare = tile_of(candidates);
+
+      TilePoint traded[9];
+      TilePoint stand_in[9];
+      std::uint8_t trades = 0;
+      for (TilePoint tile = first_spare; tile.Y < Geometry::rows; next(tile)) {
+        if (!is_safe(tile)) {
+          stand_in[trades] = tile;
+          trades += 1;
+        }
+      }
+      trades = 0;
+      for (std::uint8_t i = 0; i < 3; i += 1) {
+        for (std::uint8_t j = 0; j < 3; j += 1) {
+          const TilePoint tile{static_cast<std::uint8_t>(safe.X + j - 1),
+                               static_cast<std::uint8_t>(safe.Y + i - 1)};
+          if (tile.X < Geometry::columns && tile.Y < Geometry::rows &&
+              (tile.Y < first_spare.Y ||
+               (tile.Y == first_spare.Y && tile.X < first_spare.X))) {
+            traded[trades] = tile;
+            trades += 1;
+          }
+        }
+      }
+      const auto candidate = [&](const TilePoint & tile) {
+        for (std::uint8_t i = 0; i < trades; i += 1) {
+          if (traded[i].X == tile.X && traded[i].Y == tile.Y) {
+            return stand_in[i];
+          }
+        }
+        return tile;
+      };
+
+      // cell 'last', walked along in step with it.
+      std::uint16_t last = candidates - mines;
+      TilePoint last_tile = tile_of(last);
+
+      for (; last < candidates; last += 1) {
+        const TilePoint tile = candidate(tile_of(rand_range(last + 1)));
+        this->put_mine(this->mine_at(tile) ? candidate(last_tile) : tile);
+        next(last_tile);
+      }
+    }
+
+    // Lay a board from the seed bank, 'board' pointing at its mines: the
+    // gap of cells skipped before each, row-major, a nibble at a time, low
+    // nibble first, where a 15 adds 15 and carries on (see tools/seedbank).
+    template <class Geometry>
+    void place_mines(Geometry, const std::uint8_t * board) {
+      TilePoint tile{0, 0};
+      bool high = false;
+      for (std::uint8_t laid = 0; laid < mines;) {
+        const std::uint8_t gap = high ? (*board++ >> 4) : (*board & 0xF);
+        high = !high;
+
+        tile.X += gap;
+        for (; tile.X >= Geometry::columns; tile.X -= Geometry::columns) {
+          tile.Y += 1;
+        }
+        if (gap != 0xF) {
+          this->put_mine(tile);
+          laid += 1;
+          tile.X += 1;
+        }
+      }
     }
 
-    std::uint8_t count_mines_around(const TilePoint & selection) {
-      return count_around(mine_bits, selection);
+    // Build the mine counts and zero_bits from mine_bits, once per board, a
+    // whole row of counts at a time.
+    template <class Geometry> void count_all_mines(Geometry) {
+      for (std::uint8_t y = 0; y < Geometry::rows; y += 1) {
+        auto counts = count_row(mine_bits, y);
+        zero_bits[y].set_word(counts.zeros() & ~mine_bits[y].word() &
+                              Geometry::columns_mask);
+
+        for (std::uint8_t guard = 0; guard < RowBits::GUARD; guard += 1) {
+          counts.pop();
+        }
+        for (std::uint8_t x = 0; x < Geometry::columns; x += 1) {
+          this->put_count(TilePoint{x, y}, counts.pop());
+        }
+      }
     }
 
-    std::uint8_t count_flags_around(const TilePoint & selection) {
-      return count_around(flag_bits, selection);
+    // The board's 3BV: the fewest clicks that clear it, one per opening (a
+    // region of zero tiles, joined across edges and corners) and one per
+    // number with no zero next to it.  Needs count_all_mines() first, and
+    // zero_bits clear below the board, as reset() leaves it.
+    //
+    // Openings are labelled a row at a time.  The zeros of a row split into
+    // runs, each taken out of the row word with one add, and a run joins
+    // the opening of every run above that its bits, spread a column either
+    // way, overlap.  A run touching two openings merges them, so only the
+    // labels of this row and the one above are ever kept.
+    template <class Geometry> void count_bbbv(Geometry) {
+      static constexpr std::uint8_t RUNS_MAX = (Geometry::columns + 1) >> 1;
+
+      std::uint32_t runs[2][RUNS_MAX];
+      std::uint8_t labels[2][RUNS_MAX];
+      std::uint8_t run_count[2] = {0, 0};
+      // a new label per opening; there are fewer runs on a board than 256.
+      std::uint8_t next_label = 0;
+      bbbv = 0;
+
+      for (std::uint8_t y = 0; y < Geometry::rows; y += 1) {
+        const std::uint8_t here = y & 0b1;
+        const std::uint8_t above = here ^ 0b1;
+        run_count[here] = 0;
+
+        for (std::uint32_t zeros = zero_bits[y].word(); zeros != 0;) {
+          // adding a run's lowest bit carries through it to the bit above.
+          const std::uint32_t lowest = zeros & (~zeros + 1);
+          const std::uint32_t run = ((zeros + lowest) ^ zeros) & zeros;
+          zeros &= ~run;
+
+          const std::uint32_t reach = run | (run << 1) | (run >> 1);
+          std::uint8_t label = next_label;
+          bool joined = false;
+          for (std::uint8_t i = 0; i < run_count[above]; i += 1) {
+            const std::uint8_t other = labels[above][i];
+            if ((runs[above][i] & reach) == 0 || other == label) {
+              continue;
+            }
+            if (!joined) {
+              label = other;
+              joined = true;
+              continue;
+            }
+            for (std::uint8_t j = 0; j < run_count[above]; j += 1) {
+              if (labels[above][j] == other) {
+                labels[above][j] = label;
+              }
+            }
+            for (std::uint8_t j = 0; j < run_count[here]; j += 1) {
+              if (labels[here][j] == other) {
+                labels[here][j] = label;
+              }
+            }
+            bbbv -= 1;
+          }
+          if (!joined) {
+            next_label += 1;
+            bbbv += 1;
+          }
+
+          runs[here][run_count[here]] = run;
+          labels[here][run_count[here]] = label;
+          run_count[here] += 1;
+        }
+
+        std::uint32_t near_zero =
+            zero_bits[y - 1].word() | zero_bits[y].word() | zero_bits[y + 1].word();
+        near_zero |= (near_zero << 1) | (near_zero >> 1);
+        std::uint32_t lone = ~(mine_bits[y].word() | near_zero) & Geometry::columns_mask;
+        for (; lone != 0; lone >>= 8) {
+          bbbv += lut::bit_count[static_cast<std::uint8_t>(lone)];
+        }
+      }
+    }
+
+    std::uint8_t count_flags_around(const TilePoint & selection) const {
+      return this->flags_around_at(selection);
+    }
+
+    // Set or clear the flag on 'selection', keeping the flag counts of its
+    // (up to) 8 neighbours current.  Flags change one at a time, at the
+    // player's pace, so this is where counting them belongs rather than in
+    // the reveal and chord bursts that read the counts.
+    void put_flag(const TilePoint & selection, bool value) {
+      Tiles::put_flag(selection, value);
+
+      const std::int8_t delta = value ? 1 : -1;
+      for (std::uint8_t i = 0; i < 8; i += 1) {
+        const std::uint8_t y = selection.Y + lut::neighbour_dy[i];
+        const std::uint8_t x = selection.X + lut::neighbour_dx[i];
+        if (y < game_rows && x < game_columns) {
+          this->add_flags_around(TilePoint{x, y}, delta);
+        }
+      }
+    }
+
+    // Take back one more move, by starting or extending Job::UNDO.  A move
+    // made while an opening is revealed joins that opening's move, so the
+    // frontier only ever holds tiles of the newest move, which is the first
+    // one undone: its opening must not carry on revealing, so the frontier
+    // is emptied.
+    bool start_undo() {
+      if (!journal.request_undo()) {
+        return false;
+      }
+
+      if (job.kind == Job::REVEAL) {
+        memset(&queued_bits, 0, sizeof(queued_bits));
+      }
+      job.start(Job::UNDO);
+      return true;
     }
 
     bool set_flag(const TilePoint & selection) {
-      auto & row = flag_bits[selection.Y];
-      const bool is_setting_flag = !row.test(selection.X);
+      const bool is_setting_flag = !is_flagged(selection);
       mines_left += is_setting_flag ? -1 : 1;
-      return row.set(selection.X, !row.test(selection.X));
+      put_flag(selection, is_setting_flag);
+      return is_setting_flag;
     }
 
     bool is_flagged(const TilePoint & selection) {
-      return count_bits(flag_bits, selection);
+      return this->flag_at(selection);
     }
 
     bool is_exposed(const TilePoint & selection) {
-      return count_bits(exposed_bits, selection);
+      return this->exposed_at(selection);
     }
 
     void reset() {
+      mines_placed = false;
       timer = 0;
       time_running = false;
       mines_left = mines;
-      memset(mine_bits, 0, sizeof(mine_bits));
-      memset(exposed_bits, 0, sizeof(exposed_bits));
-      memset(flag_bits, 0, sizeof(flag_bits));
-      expose_continuation = nullptr;
+      Tiles::clear();
+      memset(&queued_bits, 0, sizeof(queued_bits));
+      memset(&zero_bits, 0, sizeof(zero_bits));
+      job.start(Job::NONE);
+      journal.clear();
       hidden_clear = (game_rows * game_columns) - mines;
     }
 
   };
 
+  // The NES has 2K of RAM to spare for everything; the C64 can afford the
+  // faster byte per tile.
+#ifdef PLATFORM_C64
+  using GameState = BasicGameState<ByteTiles>;
+#else
+  using GameState = BasicGameState<PackedTiles>;
+#endif
+
   static GameState game_state{};
 
 
@@ -476,264 +1271,824 @@ std::uint8_t cursor_anim_frame = 0;
   }
 
   bool bad_around_selection(const TilePoint & board_selection) {
-    bool is_bad = false;
-
-    if (board_selection.Y > 0) {
-      bad_flag_at(board_selection.up()) || (is_bad = true);
-      board_selection.X > 0 && (bad_flag_at(board_selection.up().left()) || (is_bad = true));
-      board_selection.X < (game_columns - 1) && (bad_flag_at(board_selection.up().right()) || (is_bad = true));
-    }
-    board_selection.X > 0 && (bad_flag_at(board_selection.left()) || (is_bad = true));
-    board_selection.X < (game_columns - 1) && (bad_flag_at(board_selection.right()) || (is_bad = true));
+    // only flags and mines can need drawing; the guard border has neither.
+    for (std::uint8_t i = 0; i < 3; i += 1) {
+      const std::uint8_t y = board_selection.Y + i - 1;
+      std::uint8_t suspects =
+          game_state.mine_bits[y].around(board_selection.X) |
+          game_state.flag_bits[y].around(board_selection.X);
+      if (i == 1) {
+        suspects &= ~0b010;
+      }
 
-    if (board_selection.Y < (game_rows - 1))
-    {
-      bad_flag_at(board_selection.down()) || (is_bad = true);
-      board_selection.X > 0 && (bad_flag_at(board_selection.down().left()) || (is_bad = true));
-      board_selection.X < (game_columns - 1) && (bad_flag_at(board_selection.down().right()) || (is_bad = true));
+      for (std::uint8_t bit = 0; bit < 3; bit += 1) {
+        (suspects & (1u << bit)) &&
+            bad_flag_at(TilePoint{
+                static_cast<std::uint8_t>(board_selection.X + bit - 1), y});
+      }
     }
 
-    return !is_bad;
+    // it's only bad if one of the tiles drawn above was a mine.
+    return game_state.count_mines_around(board_selection) == 0;
   }
 
   struct expose_result {
     bool is_ok;
-    const ExposeResultContinuation *next_expose;
+    Job::Kind next_job;
   };
 
-  struct ExposeResultContinuation {
-    virtual expose_result operator()() const = 0;
-  };
+  // Pending "expose" work, kept in game_state.queued_bits: one row of bits per
+  // board row, marking the tiles that still have to be revealed.  Pushing the
+  // neighbourhood of a tile ORs a 3-wide span into (up to) three rows, so the
+  // storage is fixed at O(rows) and a push can never be dropped.  Exposed
+  // tiles are masked out of everything that is queued, so a tile enters the
+  // frontier at most once and is revealed exactly once.  close() then grows
+  // the pushed tiles into the whole opening with bit-parallel row passes, a
+  // pass per frame, so all the logic is done before popping starts and
+  // popping only has to stream the result to the screen, a byte at a time.
+  class ExposeFrontier {
+    std::uint8_t m_row = 0; // row currently being scanned.
+    bool m_closing = false; // queued tiles not grown into their opening yet.
+
+    // OR 'tiles' into row 'y' of the queue, leaving out exposed tiles.
+    // Returns true if that queued anything new.
+    static bool queue(std::uint8_t y, std::uint32_t tiles) {
+      auto & queued = game_state.queued_bits[y];
+      const std::uint32_t before = queued.word();
+      const std::uint32_t after =
+          before | (tiles & ~game_state.exposed_bits[y].word());
+      if (after == before) {
+        return false;
+      }
+      queued.set_word(after);
+      return true;
+    }
+
+    // Close row 'y' horizontally: every queued tile that is an unflagged zero
+    // pulls in its left and right neighbours, until the row stops changing.
+    // Returns the tiles the row's zeros spread into, which is also what they
+    // spread into on the rows above and below.
+    static std::uint32_t spread_row(std::uint8_t y) {
+      const std::uint32_t spreading_zeros =
+          game_state.zero_bits[y].word() & ~game_state.flag_bits[y].word();
+
+      std::uint32_t spread = 0;
+      do {
+        const std::uint32_t zeros =
+            game_state.queued_bits[y].word() & spreading_zeros;
+        spread = zeros | (zeros << 1) | (zeros >> 1);
+      } while (queue(y, spread));
 
-  struct ExposeResultDelay : public ExposeResultContinuation {
-    virtual expose_result operator()() const {
-      if (m_skip_count--) {
-        return {true, this};
+      return spread;
+    }
+
+  public:
+    // queue the tiles surrounding 'center'.  Off the board they read as
+    // exposed, so queue() leaves them out.
+    void push_around(const TilePoint & center) {
+      const std::uint32_t span = std::uint32_t{0b111} << center.X;
+
+      queue(center.Y - 1, span);
+      queue(center.Y, span);
+      queue(center.Y + 1, span);
+    }
+
+    // Grow the queued tiles into the full opening: the zero region they
+    // touch plus its numbered border.  The growing is done by close_step(),
+    // from the reveal job, so it is not all charged to the frame of the
+    // click.
+    void close() { m_closing = true; }
+
+    bool closing() const { return m_closing; }
+
+    // One pass of close(); true once the opening is whole.
+    bool close_step() {
+      with_game_geometry([this](auto geometry) { m_closing = sweep(geometry); });
+      return !m_closing;
+    }
+
+  private:
+    // Rows are swept top to bottom and then bottom to top, carrying each
+    // row's spread to its neighbours.  Returns true if the upward sweep
+    // pushed work back down, so another pass is needed.
+    template <class Geometry> static bool sweep(Geometry) {
+      constexpr std::uint8_t last_row = Geometry::rows - 1;
+
+      for (std::uint8_t y = 0; y <= last_row; y += 1) {
+        const auto spread = spread_row(y);
+        queue(y - 1, spread);
+        queue(y + 1, spread);
       }
 
-      return {true, m_next};
+      bool changed = false;
+      for (std::uint8_t y = last_row + 1; y-- > 0;) {
+        const auto spread = spread_row(y);
+        queue(y - 1, spread);
+        queue(y + 1, spread) && (changed = true);
+      }
+      return changed;
     }
 
-    static std::uint8_t                     m_skip_count;
-    static const ExposeResultContinuation * m_next;
+  public:
+    // Pop the next queued tile.  Returns false once no work is left on any
+    // row.  Tiles can still be exposed by other means (e.g. a chord) while
+    // they wait, so those are dropped here a byte at a time.
+    bool pop(TilePoint & next) {
+      for (std::uint8_t rows_checked = 0; rows_checked < game_rows;
+           rows_checked += 1) {
+        auto & queued = game_state.queued_bits[m_row];
+        const auto & exposed = game_state.exposed_bits[m_row];
+
+        for (std::uint8_t i = 0; i < sizeof(queued.m_bits); i += 1) {
+          auto & queued_byte = queued.m_bits[i];
+          queued_byte &= ~exposed.m_bits[i];
+
+          if (queued_byte != std::byte{0}) {
+            const std::uint8_t bit =
+                lut::lowest_bit[std::to_integer<std::uint8_t>(queued_byte)];
+            queued_byte &= ~lut::bit_mask[bit];
+            next = TilePoint{
+                static_cast<std::uint8_t>((i << 3) + bit - RowBits::GUARD),
+                m_row};
+            return true;
+          }
+        }
+
+        // m_row may be left over from a bigger board.
+        m_row = m_row + 1 >= game_rows ? 0 : m_row + 1;
+      }
+
+      return false;
+    }
   };
 
-  std::uint8_t ExposeResultDelay::m_skip_count = 0;
-  const ExposeResultContinuation * ExposeResultDelay::m_next = nullptr;
+  ZP_BSS ExposeFrontier expose_frontier;
+
+  // Job::REVEAL: draw the tiles queued in the expose frontier.
+  Job::Status reveal_step() {
+    // a pass of growing the opening is this frame's work; popping a tile
+    // before it is whole would lose the zeros it still has to spread from.
+    if (expose_frontier.closing()) {
+      expose_frontier.close_step();
+      return Job::YIELD;
+    }
 
-  ExposeResultDelay expose_delay;
+    // Reveal as many tiles as the platform can still draw this frame; the
+    // rest stays queued in the frontier for the next one.
+    const std::uint8_t budget = target::graphics::place_budget();
+    std::uint8_t drawn = 0;
 
-  OptionalTilePoint filter_already_exposed(const OptionalTilePoint & src) {
-    return src.is_valid && !game_state.exposed_bits[src.Y].test(src.X) ? src : OptionalTilePoint{};
-  }
+    TilePoint expose_target;
+    while (drawn < budget && expose_frontier.pop(expose_target)) {
 
-  class ExposeBuffer {
-    static_assert(COLUMNS_MAX + ROWS_MAX < 256);
+      const auto flagged = game_state.is_flagged(expose_target);
 
-    static constexpr std::uint8_t STATIC_SIZE = COLUMNS_MAX + ROWS_MAX;
+      if (game_state.count_mine(expose_target) && !flagged) {
+        GameBoardDraw::Mine(expose_target);
+        return Job::FAILED;
+      }
+
+      // bad-flag check.
+      if (flagged) {
+        game_state.exposed_test_and_set(expose_target);
+        if (!game_state.count_mine(expose_target)) {
+          drawn += 1;
+          if (!bad_flag_at(expose_target))
+          {
+            return Job::FAILED;
+          }
+        }
+        continue;
+      }
+
+      const auto mine_count = game_state.count_mines_around(expose_target);
+      if (game_state.count_flags_around(expose_target) > mine_count) {
+        // left hidden, so exposed tiles and hidden_clear still agree.
+        return bad_around_selection(expose_target) ? Job::DONE : Job::FAILED;
+      }
 
-    TilePoint data[STATIC_SIZE];
-    std::uint8_t m_begin = 0;
-    std::uint8_t m_size = 0;
+      game_state.exposed_test_and_set(expose_target);
+      GameBoardDraw::ShowCount(mine_count, expose_target);
+      drawn += 1;
 
-    std::uint8_t end_index() const {
-      return (m_begin + m_size) % STATIC_SIZE;
-    }
-    TilePoint & end_ref() {
-      return data[end_index()];
+      game_state.hidden_clear -= 1;
     }
 
+    return drawn == budget ? Job::YIELD : Job::DONE;
+  }
+
+  // Walks the board 8 tiles (one byte of a row) at a time, visiting the tiles
+  // a job selects with a byte mask.  Empty bytes are skipped without looking
+  // at their tiles, and the walk stops whenever the frame's draw budget runs
+  // out, resuming at the same tile next frame.
+  class BoardSweep {
+    std::uint8_t m_row = 0;
+    std::uint8_t m_byte = 0;        // byte of m_row that m_pending came from.
+    std::byte m_pending{0};         // selected tiles not visited yet.
+
   public:
-    void push_back(const OptionalTilePoint & optional_tile_point) {
-      if (optional_tile_point.is_valid && m_size < STATIC_SIZE) {
-        end_ref() = optional_tile_point;
-        m_size += 1;
+    void start() {
+      m_row = 0;
+      m_byte = 0;
+      m_pending = std::byte{0};
+    }
+
+    // 'select(row, byte)' returns the tiles of that byte to visit, and
+    // 'visit(tile)' draws one of them.
+    template <class Select, class Visit>
+    Job::Status step(Select select, Visit visit) {
+      const std::uint8_t budget = target::graphics::place_budget();
+
+      for (std::uint8_t drawn = 0; drawn < budget; drawn += 1) {
+        while (m_pending == std::byte{0}) {
+          if (m_row == game_rows) {
+            return Job::DONE;
+          }
+          m_pending = select(m_row, m_byte);
+          if (m_pending == std::byte{0}) {
+            next_byte();
+          }
+        }
+
+        const std::uint8_t bit =
+            lut::lowest_bit[std::to_integer<std::uint8_t>(m_pending)];
+        m_pending &= ~lut::bit_mask[bit];
+
+        visit(TilePoint{
+            static_cast<std::uint8_t>((m_byte << 3) + bit - RowBits::GUARD),
+            m_row});
+
+        if (m_pending == std::byte{0}) {
+          next_byte();
+        }
       }
+
+      return Job::YIELD;
     }
 
-    void push_front(const OptionalTilePoint & optional_tile_point) {
-      if (optional_tile_point.is_valid && m_size < STATIC_SIZE) {
-        m_begin = m_begin == 0 ? STATIC_SIZE - 1 : m_begin - 1;
-        data[m_begin] = optional_tile_point;
-        m_size += 1;
+  private:
+    void next_byte() {
+      m_byte += 1;
+      if (m_byte == sizeof(RowBits)) {
+        m_byte = 0;
+        m_row += 1;
       }
     }
+  };
+
+  ZP_BSS BoardSweep board_sweep;
+
+  // Job::GAME_OVER_SWEEP: every unflagged mine is drawn as a mine and every
+  // flag that isn't on a mine as wrong; correctly flagged mines are left be.
+  Job::Status game_over_sweep_step() {
+    return board_sweep.step(
+        [](std::uint8_t row, std::uint8_t byte) {
+          return game_state.mine_bits[row].m_bits[byte] ^
+                 game_state.flag_bits[row].m_bits[byte];
+        },
+        [](const TilePoint & tile) {
+          if (game_state.count_mine(tile)) {
+            GameBoardDraw::Mine(tile);
+          } else {
+            GameBoardDraw::Wrong(tile);
+          }
+        });
+  }
+
+  // Job::WIN_SWEEP: every mine not flagged yet gets a flag.  The mine
+  // counter is only zeroed once the sweep is done, so it is redrawn once
+  // instead of once per tile.
+  Job::Status win_sweep_step() {
+    const auto status = board_sweep.step(
+        [](std::uint8_t row, std::uint8_t byte) {
+          return game_state.mine_bits[row].m_bits[byte] &
+                 ~game_state.flag_bits[row].m_bits[byte];
+        },
+        [](const TilePoint & tile) {
+          game_state.put_flag(tile, true);
+          GameBoardDraw::Flag(tile);
+        });
+
+    if (status == Job::DONE) {
+      game_state.mines_left = 0;
+    }
+
+    return status;
+  }
+
+  // Job::UNDO: replay the journal backwards, newest change first, hiding
+  // revealed tiles and toggling flags back, until the moves asked for are
+  // undone.
+  Job::Status undo_step() {
+    auto & journal = game_state.journal;
+    const std::uint8_t budget = target::graphics::place_budget();
+
+    for (std::uint8_t drawn = 0; drawn < budget;) {
+      if (!journal.undoing()) {
+        return Job::DONE;
+      }
+
+      const auto tile = journal.newest_tile();
+      switch (journal.newest_kind()) {
+      case Journal::MOVE:
+        break;
+      case Journal::FLAG:
+        if (game_state.set_flag(tile)) {
+          GameBoardDraw::Flag(tile);
+        } else {
+          GameBoardDraw::Hide(tile);
+        }
+        drawn += 1;
+        break;
+      case Journal::REVEAL:
+        game_state.put_exposed(tile, false);
+        // a flag inside an opening is exposed without being counted, and
+        // may have been drawn as wrong.
+        if (game_state.is_flagged(tile)) {
+          GameBoardDraw::Flag(tile);
+        } else {
+          game_state.hidden_clear += 1;
+          GameBoardDraw::Hide(tile);
+        }
+        drawn += 1;
+        break;
+      }
 
-    TilePoint pop_back() {
-      --m_size;
-      return end_ref();
+      journal.drop_newest_tile();
     }
 
-    void clear() { 
-      m_begin = 0; 
-      m_size = 0;
+    return journal.undoing() ? Job::YIELD : Job::DONE;
+  }
+
+  expose_result expose_recurse(const TilePoint & board_selection,
+                               std::uint8_t depth);
+
+  // Job::GENERATE: deal boards until one can be solved from its first tile
+  // by deduction alone.  Each board is laid in game_state, then played by a
+  // solver that knows only what the player would: which tiles it has
+  // revealed (m_safe) and proven to be mines (m_mine), and the counts of the
+  // revealed tiles.  Passes over the board apply two rules to every
+  // revealed tile next to unknown ones:
+  //  - a tile whose count is met by known mines makes its unknown
+  //    neighbours safe, and one whose count needs all of them makes them
+  //    mines;
+  //  - only when that is stuck, a tile whose unknown neighbours are a
+  //    subset of a nearby tile's decides the rest of the nearby tile's.
+  // A board is good once every safe tile is revealed, and thrown away when
+  // a pass of both rules learns nothing.  The work is sliced by the frame's
+  // draw budget, like the other jobs.
+  //
+  // The first tile is the middle of the board, so a board found while the
+  // difficulty menu waits can be kept and dealt later: only the random state
+  // it was laid from is remembered.
+  class NoGuessGenerator {
+  public:
+    // Search for a board of the current preset.  If 'play', the board is
+    // for the game just reset: it is laid and its first tile opened as soon
+    // as it is found, straight away if one was found already.
+    void start(bool play) {
+      m_play = play;
+      m_first = TilePoint{static_cast<std::uint8_t>(game_columns >> 1),
+                          static_cast<std::uint8_t>(game_rows >> 1)};
+
+      // a preset with boards in the seed bank never needs a search.
+      const std::uint16_t banked = SEED_BANK_BOARDS[game_preset];
+      if (banked != 0) {
+        if (game_state.job.kind == Job::GENERATE) {
+          game_state.job.start(Job::NONE);
+        }
+        if (play) {
+          const std::uint8_t * board = SEED_BANK_DATA[game_preset] +
+              SEED_BANK_OFFSETS[game_preset][rand_range(banked)];
+          game_state.clear();
+          with_game_geometry([board](auto geometry) {
+            game_state.place_mines(geometry, board);
+            game_state.count_all_mines(geometry);
+          });
+          deal();
+        }
+        return;
+      }
+
+      if (m_preset == game_preset) {
+        if (m_found) {
+          if (play) {
+            relay();
+            deal();
+          }
+          return;
+        }
+        // a search for this preset was cut short, by a reset or by leaving
+        // no-guess mode, which cleared its board: lay it again and carry on.
+        if (m_solving) {
+          relay();
+        }
+      } else {
+        m_found = false;
+        m_preset = game_preset;
+        m_solving = false;
+      }
+      game_state.job.start(Job::GENERATE);
     }
 
-    auto size() const { return m_size; }
-    bool empty() const { return size() == 0; }
+    Job::Status step() {
+      if (!m_solving) {
+        m_seed = rand_save();
+        lay();
+        solve_start();
+        return Job::YIELD;
+      }
 
-    class const_iterator {
-    private:
-      std::uint8_t logical_index = 0;
-      const ExposeBuffer * m_container = nullptr;
+      // the frame's drawing budget stands for its time, as it does for the
+      // jobs that draw.
+      const std::uint8_t budget = target::graphics::place_budget();
+      for (std::uint8_t spent = 0; spent < budget;
+           spent += m_subsets ? SUBSET_VISIT_COST : 1) {
+        while (m_pending == 0) {
+          if (m_row == game_rows && !end_pass()) {
+            return found();
+          }
+          if (!m_solving) {
+            return Job::YIELD;
+          }
+          m_pending = frontier(m_row);
+          m_pending_row = m_row;
+          m_row += 1;
+        }
 
-    public:
-      const_iterator(const ExposeBuffer *container) : m_container{container} {}
-      const_iterator(const ExposeBuffer *container, std::uint8_t idx)
-          : m_container{container}, logical_index{idx} {}
+        const std::uint8_t bit = lowest_bit(m_pending);
+        m_pending &= m_pending - 1;
+        visit(TilePoint{static_cast<std::uint8_t>(bit - RowBits::GUARD),
+                        m_pending_row});
+      }
 
-      const TilePoint & operator*() const {
-        return m_container->data[(m_container->m_begin + logical_index) % STATIC_SIZE];
+      return Job::YIELD;
+    }
+
+  private:
+    // A visit by the first rule is taken to cost about as much time as
+    // drawing a tile, and one by the subset rule, which builds a 7x7 window
+    // and compares up to 24 neighbours with it, about as much as this many.
+    // Both are estimates, not measured.  A new board is laid in a slice of
+    // its own.
+    static constexpr std::uint8_t SUBSET_VISIT_COST = 4;
+
+    void lay() {
+      game_state.clear();
+      with_game_geometry([this](auto geometry) {
+        game_state.place_mines(geometry, m_first);
+        game_state.count_all_mines(geometry);
+      });
+    }
+
+    // lay the board of m_seed again, leaving the random sequence as it is.
+    void relay() {
+      const std::uint32_t state = rand_save();
+      rand_restore(m_seed);
+      lay();
+      rand_restore(state);
+    }
+
+    // the board in game_state is the one to play.
+    void deal() {
+      // the first tile is a zero, so its opening is one click of the 3BV,
+      // and one the player never makes.
+      with_game_geometry([](auto geometry) { game_state.count_bbbv(geometry); });
+      game_state.bbbv -= 1;
+      m_found = false;
+      game_state.mines_placed = true;
+      game_state.job.start(expose_recurse(m_first, 0).next_job);
+    }
+
+    Job::Status found() {
+      m_found = true;
+      m_solving = false;
+      if (m_play) {
+        deal();
       }
+      return Job::DONE;
+    }
 
-      const_iterator & operator++() {
-        ++logical_index;
-        return *this;
+    void solve_start() {
+      // like exposed_bits, the guard border counts as revealed.
+      memset(&m_safe, 0xFF, sizeof(m_safe));
+      for (std::uint8_t y = 0; y < game_rows; y += 1) {
+        m_safe[y].set_word(~columns_mask());
       }
+      memset(&m_mine, 0, sizeof(m_mine));
+      memset(&m_dirty, 0, sizeof(m_dirty));
 
-      bool operator==(const const_iterator & other) const {
-        return logical_index == other.logical_index;
+      m_safe[m_first.Y].set(m_first.X);
+      m_dirty[m_first.Y].set(m_first.X);
+      m_hidden = game_rows * game_columns - mines - 1;
+
+      m_row = 0;
+      m_pending = 0;
+      m_progress = false;
+      m_subsets = false;
+      m_solving = true;
+    }
+
+    // Called with a pass over the board done; false once the board is
+    // solved.  A pass that learns nothing is retried with the subset rule,
+    // and if that learns nothing either the next slice deals a new board.
+    bool end_pass() {
+      if (m_hidden == 0) {
+        return false;
       }
 
-      bool operator!=(const const_iterator & other) const {
-        return !operator==(other);
+      if (m_progress) {
+        m_subsets = false;
+      } else if (!m_subsets) {
+        m_subsets = true;
+      } else {
+        m_solving = false;
       }
-    };
 
-    auto begin() const { return const_iterator{this}; }
-    auto end() const { return const_iterator{this, m_size}; }
+      m_row = 0;
+      m_progress = false;
+      return true;
+    }
 
-  };
+    std::uint32_t unknown(std::uint8_t y) const {
+      return ~(m_safe[y].word() | m_mine[y].word());
+    }
 
-  ExposeBuffer expose_buffer;
-  TilePoint prev_exposed;
-
-  OptionalTilePoint filter_around_prev_expose(const OptionalTilePoint &src) {
-    const auto x_distance = src.X > prev_exposed.X ? src.X - prev_exposed.X
-                                                   : prev_exposed.X - src.X;
-    const auto y_distance = src.Y > prev_exposed.Y ? src.Y - prev_exposed.Y
-                                                   : prev_exposed.Y - src.Y;
-    return src.is_valid && (x_distance > 1 || y_distance > 1)
-               ? src
-               : OptionalTilePoint{};
-  }
+    // the revealed tiles of row 'y' next to a tile not known yet, and still
+    // to be visited this pass: all of them for the subset rule, else only
+    // those whose neighbours changed since their last visit.
+    std::uint32_t frontier(std::uint8_t y) {
+      std::uint32_t next_to =
+          unknown(y - 1) | unknown(y) | unknown(y + 1);
+      next_to |= (next_to << 1) | (next_to >> 1);
 
-  void
-  append_back_expose_buffer(const OptionalTilePoint &board_selection_optional) {
-    {
-      const auto left_tile = board_selection_optional.left();
-      expose_buffer.push_front(
-          filter_already_exposed(filter_around_prev_expose(left_tile.down())));
-      expose_buffer.push_front(
-          filter_already_exposed(filter_around_prev_expose(left_tile)));
-      expose_buffer.push_front(
-          filter_already_exposed(filter_around_prev_expose(left_tile.up())));
+      const std::uint32_t dirty = m_dirty[y].word();
+      m_dirty[y].set_word(0);
+      return m_safe[y].word() & next_to & columns_mask() &
+             (m_subsets ? ~std::uint32_t{0} : dirty);
     }
 
-    expose_buffer.push_front(filter_already_exposed(
-        filter_around_prev_expose(board_selection_optional.up())));
+    static std::uint8_t lowest_bit(std::uint32_t bits) {
+      std::uint8_t bit = 0;
+      for (; (bits & 0xFF) == 0; bits >>= 8) {
+        bit += 8;
+      }
+      return bit + lut::lowest_bit[static_cast<std::uint8_t>(bits)];
+    }
+
+    // the mines 'tile' still needs among its unknown neighbours, whose
+    // 3-wide row masks are put in 'around'.
+    std::uint8_t mines_needed(const TilePoint & tile, std::uint8_t around[3]) const {
+      std::uint8_t marked = 0;
+      for (std::uint8_t i = 0; i < 3; i += 1) {
+        const std::uint8_t y = tile.Y + i - 1;
+        const std::uint8_t mine = m_mine[y].around(tile.X);
+        around[i] = ~(m_safe[y].around(tile.X) | mine) & 0b111;
+        marked += lut::bit_count[mine];
+      }
+      return game_state.count_mines_around(tile) - marked;
+    }
 
-    {
-      const auto right_tile = board_selection_optional.right();
-      expose_buffer.push_front(
-          filter_already_exposed(filter_around_prev_expose(right_tile.up())));
-      expose_buffer.push_front(
-          filter_already_exposed(filter_around_prev_expose(right_tile)));
-      expose_buffer.push_front(
-          filter_already_exposed(filter_around_prev_expose(right_tile.down())));
+    void visit(const TilePoint & tile) {
+      std::uint8_t around[3];
+      const std::uint8_t needed = mines_needed(tile, around);
+      const std::uint8_t unknowns = lut::bit_count[around[0]] +
+                                    lut::bit_count[around[1]] +
+                                    lut::bit_count[around[2]];
+
+      if (needed == 0 || needed == unknowns) {
+        for (std::uint8_t i = 0; i < 3; i += 1) {
+          learn(tile.Y + i - 1, tile.X, around[i], needed == 0);
+        }
+      } else if (m_subsets) {
+        visit_neighbours(tile, around, needed);
+      }
     }
 
-    expose_buffer.push_front(filter_already_exposed(
-        filter_around_prev_expose(board_selection_optional.down())));
-  }
+    // Compare 'tile' with the revealed tiles up to 2 away, in a 7x7 window
+    // of unknown tiles around it: bit N of window[K] is the tile at column
+    // X - 3 + N of row Y - 3 + K, which is bit X - 2 + N of a row word.
+    static_assert(RowBits::GUARD == 1);
+
+    void visit_neighbours(const TilePoint & tile, const std::uint8_t around[3],
+                          std::uint8_t needed) {
+      std::uint8_t window[7];
+      for (std::uint8_t k = 0; k < 7; k += 1) {
+        const std::uint8_t y = tile.Y + k - 3;
+        RowBits row;
+        row.set_word(y < game_rows ? unknown(y) : 0);
+        window[k] = static_cast<std::uint8_t>(
+                        tile.X >= 2 ? row.slice(tile.X - 2)
+                                    : row.slice(0) << (2 - tile.X)) &
+                    0x7F;
+      }
 
-  void
-  init_back_expose_buffer(const OptionalTilePoint &board_selection_optional) {
-    
-    {
-      const auto left_tile = board_selection_optional.left();
-      expose_buffer.push_back(filter_already_exposed(left_tile.down()));
-      expose_buffer.push_back(filter_already_exposed(left_tile));
-      expose_buffer.push_back(filter_already_exposed(left_tile.up()));
+      for (std::uint8_t i = 0; i < 5; i += 1) {
+        for (std::uint8_t j = 0; j < 5; j += 1) {
+          const TilePoint other{static_cast<std::uint8_t>(tile.X + j - 2),
+                                static_cast<std::uint8_t>(tile.Y + i - 2)};
+          if ((i == 2 && j == 2) || other.X >= game_columns ||
+              other.Y >= game_rows || !m_safe[other.Y].test(other.X)) {
+            continue;
+          }
+
+          // this tile's unknown neighbours must all be among the other's,
+          // which are rows i to i + 2 of the window.
+          bool subset = true;
+          for (std::uint8_t k = 0; k < 3; k += 1) {
+            const std::uint8_t row = k + 2;
+            const std::uint8_t others =
+                static_cast<std::uint8_t>(row - i) < 3
+                    ? window[row] & (0b111 << j)
+                    : 0;
+            subset = subset && ((around[k] << 2) & ~others) == 0;
+          }
+          if (!subset) {
+            continue;
+          }
+
+          // the other tile's unknown neighbours, less this tile's.
+          std::uint8_t rest[3];
+          std::uint8_t rest_count = 0;
+          for (std::uint8_t k = 0; k < 3; k += 1) {
+            const std::uint8_t row = i + k;
+            const std::uint8_t ours =
+                static_cast<std::uint8_t>(row - 2) < 3 ? around[row - 2] << 2
+                                                       : 0;
+            rest[k] = window[row] & (0b111 << j) & ~ours;
+            rest_count += lut::bit_count[rest[k]];
+          }
+          if (rest_count == 0) {
+            continue;
+          }
+
+          std::uint8_t other_around[3];
+          const std::uint8_t other_needed = mines_needed(other, other_around);
+          if (other_needed == needed ||
+              other_needed - needed == rest_count) {
+            for (std::uint8_t k = 0; k < 3; k += 1) {
+              const std::uint8_t y = other.Y + k - 1;
+              if (tile.X >= 2) {
+                learn(y, tile.X - 2, rest[k], other_needed == needed);
+              } else {
+                learn(y, 0, rest[k] >> (2 - tile.X), other_needed == needed);
+              }
+            }
+            return;
+          }
+        }
+      }
     }
 
-    expose_buffer.push_back(
-        filter_already_exposed(board_selection_optional.up()));
+    // the tiles of 'slice' in row 'y', bit N being bit 'bit' + N of a row
+    // word, are now known to be safe, or mines.
+    void learn(std::uint8_t y, std::uint8_t bit, std::uint8_t slice, bool safe) {
+      if (slice == 0) {
+        return;
+      }
 
-    {
-      const auto right_tile = board_selection_optional.right();
-      expose_buffer.push_back(filter_already_exposed(right_tile.up()));
-      expose_buffer.push_back(filter_already_exposed(right_tile));
-      expose_buffer.push_back(filter_already_exposed(right_tile.down()));
+      RowBits learned;
+      learned.set_word(0);
+      learned.set_slice(bit, slice);
+      std::uint32_t bits = learned.word();
+
+      m_progress = true;
+      const std::uint32_t around = bits | (bits << 1) | (bits >> 1);
+      for (std::uint8_t i = 0; i < 3; i += 1) {
+        auto & dirty = m_dirty[static_cast<std::uint8_t>(y + i - 1)];
+        dirty.set_word(dirty.word() | around);
+      }
+
+      if (safe) {
+        m_safe[y].set_word(m_safe[y].word() | bits);
+        for (; bits; bits &= bits - 1) {
+          m_hidden -= 1;
+        }
+      } else {
+        m_mine[y].set_word(m_mine[y].word() | bits);
+      }
     }
 
-    expose_buffer.push_back(
-        filter_already_exposed(board_selection_optional.down()));
-  }
+    BoardBits m_safe;
+    BoardBits m_mine;
+    BoardBits m_dirty; // tiles whose neighbours were learned since a visit.
+    std::uint32_t m_pending = 0; // frontier of m_pending_row not visited yet.
+    std::uint16_t m_hidden = 0;  // safe tiles not revealed yet.
+    std::uint32_t m_seed = 0; // the random state the board was laid from.
+    TilePoint m_first{0, 0};
+    std::uint8_t m_row = 0;
+    std::uint8_t m_pending_row = 0;
+    std::uint8_t m_preset = 0;
+    bool m_play = false;
+    bool m_found = false;
+    bool m_solving = false;
+    bool m_progress = false;
+    bool m_subsets = false;
+  };
 
-  struct ExposeResultNext final : public ExposeResultContinuation {
-    expose_result operator()() const override {
-      static constexpr std::uint8_t MAX_EXPOSE_PER_ITER = 1;
-      std::uint8_t exposed = 0;
+  NoGuessGenerator no_guess_generator;
 
-      while (!expose_buffer.empty()) {
+  Job::Status Job::resume() {
+    const Kind resumed = kind;
+    Status status = DONE;
 
-        const auto expose_target = expose_buffer.pop_back();
-        const auto flagged = game_state.is_flagged(expose_target);
+    switch (kind) {
+    case NONE:
+      break;
+    case REVEAL:
+      status = reveal_step();
+      break;
+    case GAME_OVER_SWEEP:
+      status = game_over_sweep_step();
+      break;
+    case WIN_SWEEP:
+      status = win_sweep_step();
+      break;
+    case UNDO:
+      status = undo_step();
+      break;
+    case GENERATE:
+      status = no_guess_generator.step();
+      break;
+    }
 
-        if (game_state.count_mine(expose_target) && !flagged) {
-          GameBoardDraw::Mine(expose_target);
-          return {false, nullptr};
-        }
+    // a finished job may have handed over to another by starting it.
+    if (status != YIELD && kind == resumed) {
+      kind = NONE;
+    }
 
-        if (game_state.exposed_test_and_set(expose_target)) {
+    return status;
+  }
+
+  // Resolve a click on an exposed number whose flags are all placed, in one
+  // go.  The 3x3 block around the selection is read once as small masks: bit
+  // N of a row mask is column (X - 1 + N) of that board row.  The guard
+  // border reads as exposed, so tiles off the board are never picked.
+  expose_result chord(const TilePoint & board_selection) {
+    std::uint8_t reveal[3];
+    std::uint8_t hidden_mines = 0;
+    for (std::uint8_t i = 0; i < 3; i += 1) {
+      const std::uint8_t y = board_selection.Y + i - 1;
+      reveal[i] = ~(game_state.exposed_bits[y].around(board_selection.X) |
+                    game_state.flag_bits[y].around(board_selection.X)) &
+                  0b111;
+      hidden_mines |= reveal[i] & game_state.mine_bits[y].around(board_selection.X);
+    }
+
+    // a mine left unflagged means one of the flags is wrong.
+    if (hidden_mines) {
+      return {bad_around_selection(board_selection), Job::NONE};
+    }
+
+    // a tile with more flags around it than mines also means a wrong flag.
+    // Every tile is checked before any is revealed, so a chord is either
+    // done whole or not at all.
+    for (std::uint8_t i = 0; i < 3; i += 1) {
+      for (std::uint8_t bit = 0; bit < 3; bit += 1) {
+        if (!(reveal[i] & (1u << bit))) {
           continue;
         }
 
-        // bad-flag check.
-        if (flagged) {
-          if (!game_state.count_mine(expose_target)) {
-            if (!bad_flag_at(expose_target))
-            {
-              return {false, nullptr};
-            }
-          }
-          continue;
+        const TilePoint target{
+            static_cast<std::uint8_t>(board_selection.X + bit - 1),
+            static_cast<std::uint8_t>(board_selection.Y + i - 1)};
+        if (game_state.count_flags_around(target) >
+            game_state.count_mines_around(target)) {
+          return {bad_around_selection(target), Job::NONE};
         }
+      }
+    }
 
-        const auto mine_count = game_state.count_mines_around(expose_target);
-        if (game_state.count_flags_around(expose_target) > mine_count) {
-          return {bad_around_selection(expose_target), nullptr};
+    bool opening = false;
+    for (std::uint8_t i = 0; i < 3; i += 1) {
+      for (std::uint8_t bit = 0; bit < 3; bit += 1) {
+        if (!(reveal[i] & (1u << bit))) {
+          continue;
         }
 
-        GameBoardDraw::ShowCount(mine_count, expose_target);
-        exposed += 1;
+        const TilePoint target{
+            static_cast<std::uint8_t>(board_selection.X + bit - 1),
+            static_cast<std::uint8_t>(board_selection.Y + i - 1)};
+        const auto mine_count = game_state.count_mines_around(target);
 
+        game_state.exposed_test_and_set(target);
+        GameBoardDraw::ShowCount(mine_count, target);
         game_state.hidden_clear -= 1;
 
         if (mine_count == 0) {
-          append_back_expose_buffer(expose_target);
-          prev_exposed = expose_target;
-        }
-
-        // Early exit by limiting the max number of "expose" tiles that change in the current
-        // invocation of this call.
-        if (exposed == MAX_EXPOSE_PER_ITER) {
-          // copy the un-traversed region of the front buffer to the back
-          // buffer, so it will be examined at some point in the future.
-          // for (const auto &unexposed_tile : *front_expose_buffer) {
-          //   back_expose_buffer->push_back(unexposed_tile);
-          // }
-
-          break;
+          expose_frontier.push_around(target);
+          opening = true;
         }
       }
+    }
 
-      return {true, expose_buffer.empty() ? nullptr : this};
+    if (opening) {
+      expose_frontier.close();
+      return {true, Job::REVEAL};
     }
-  };
 
-  const ExposeResultNext expose_must_continue;
+    return {true, Job::NONE};
+  }
 
   expose_result
   expose_recurse(const TilePoint & board_selection, std::uint8_t depth) {
@@ -741,12 +2096,12 @@ std::uint8_t cursor_anim_frame = 0;
     const auto flagged = game_state.is_flagged(board_selection);
     if (game_state.count_mine(board_selection) && !flagged) {
       GameBoardDraw::Mine(board_selection);
-      return {false, nullptr};
+      return {false, Job::NONE};
     }
 
     if (flagged)
     {
-      return {true, nullptr};
+      return {true, Job::NONE};
     }
 
     const auto already_exposed =
@@ -759,31 +2114,36 @@ std::uint8_t cursor_anim_frame = 0;
     const auto flag_count = game_state.count_flags_around(board_selection);
 
     if (flag_count > mine_count) {
-      return {bad_around_selection(board_selection), nullptr};
+      return {bad_around_selection(board_selection), Job::NONE};
     }
 
     GameBoardDraw::ShowCount(mine_count, board_selection);
 
-    if (mine_count == 0 || (already_exposed && flag_count == mine_count)) {
-      expose_buffer.clear();
-      init_back_expose_buffer(board_selection);
-      prev_exposed = board_selection;
-      return {true, &expose_must_continue};
+    if (already_exposed && mine_count != 0 && flag_count == mine_count) {
+      return chord(board_selection);
+    }
+
+    if (mine_count == 0) {
+      expose_frontier.push_around(board_selection);
+      expose_frontier.close();
+      return {true, Job::REVEAL};
     }
 
-    return {true, nullptr};
+    return {true, Job::NONE};
   }
 
   struct ClockUpdater {
     std::uint8_t frames_per_second = 0;
     std::uint8_t current_frames = 0;
     bool operator()() {
+      // only redraw when the seconds change, leaving the rest of the frames'
+      // tile updates for revealing the board.
       if (++current_frames == frames_per_second) {
         game_state.timer += 1;
         current_frames = 0;
+        GameBoardDraw::DrawTime(game_state.timer);
       }
 
-      GameBoardDraw::DrawTime(game_state.timer);
       return true;
     }
   };
@@ -865,8 +2225,17 @@ std::uint8_t cursor_anim_frame = 0;
   class ScoreUpdate {
     public:
     void operator()() {
-      GameBoardDraw::DrawScore(game_state.mines_left);
+      if (game_state.mines_left != m_drawn) {
+        m_drawn = game_state.mines_left;
+        GameBoardDraw::DrawScore(m_drawn);
+      }
     }
+
+    // the board was redrawn, showing 000.
+    void invalidate() { m_drawn = 0; }
+
+    private:
+    std::uint8_t m_drawn = 0;
   };
 
   ScoreUpdate score_updater;
@@ -874,6 +2243,7 @@ std::uint8_t cursor_anim_frame = 0;
   void reset() {
 
     GameBoardDraw::DrawBoard();
+    score_updater.invalidate();
 
 #ifdef PLATFORM_C64
     sprite_background.position(
@@ -885,18 +2255,23 @@ std::uint8_t cursor_anim_frame = 0;
     static std::uint8_t cursor_current_frameskip = 0;
 
     game_state.reset();
-
-    for (std::uint8_t mines_left = mines; mines_left;) {
-      const auto rownum = static_cast<std::uint8_t>(rand() >> 8) % game_rows;
-      auto &row = game_state.mine_bits[rownum];
-      const auto column = static_cast<std::uint8_t>(rand() >> 8) % game_columns;
-      if (!row.test(column)) {
-        row.set(column);
-        mines_left -= 1;
-      }
+    if (no_guess) {
+      no_guess_generator.start(true);
     }
   }
 
+  // Lay the mines once the first tile to open is known, keeping it and its
+  // neighbours clear so the first click always opens an area.  This runs
+  // in the frame of the click, before the tile is exposed.
+  void generate_board(const TilePoint & first_click) {
+    with_game_geometry([&first_click](auto geometry) {
+      game_state.place_mines(geometry, first_click);
+      game_state.count_all_mines(geometry);
+      game_state.count_bbbv(geometry);
+    });
+    game_state.mines_placed = true;
+  }
+
   CursorAnimateFunc cursor_animator;
 
   FireButtonEventFilter fire_button_handler;
@@ -958,22 +2333,31 @@ std::uint8_t cursor_anim_frame = 0;
     static bool suppress_expose;
   };
 
-  TilePoint AppModeGame::current_selected{0, 0};
+  ZP_BSS TilePoint AppModeGame::current_selected{0, 0};
   bool AppModeGame::suppress_expose = false;
 
   struct AppModeResetButton : public AppMode {
     void on_init(AppMode *) override{}
     AppMode *on_vsync(FireButtonEventFilter::Event, key_scan_res) override;
+
+    // Holding fire undid moves, so letting go goes back to the board
+    // instead of starting a new game.
+    static bool undo_held;
   };
 
+  bool AppModeResetButton::undo_held = false;
+
 #ifdef PLATFORM_C64
   constexpr auto HELP1 =
       GameBoardDraw::GenerateTileString("FIRE OR SPACE BUTTON EXPOSES TILES");
   constexpr auto HELP2 = GameBoardDraw::GenerateTileString(
       "HOLD FIRE BUTTON TO MARK TILE");
+  constexpr auto HELP3 = GameBoardDraw::GenerateTileString(
+      "HOLD FIRE ON THE FACE TO UNDO");
 #elif defined(PLATFORM_NES_NROM_128)
   constexpr auto HELP1 = GameBoardDraw::GenerateTileString("BUTTON A EXPOSE");
   constexpr auto HELP2 = GameBoardDraw::GenerateTileString("BUTTON B MARK");
+  constexpr auto HELP3 = GameBoardDraw::GenerateTileString("HOLD A ON FACE UNDO");
 #endif
 
   struct AppModeSelectDifficulty : public AppMode {
@@ -987,6 +2371,8 @@ std::uint8_t cursor_anim_frame = 0;
           GameBoardDraw::GenerateTileString("INTERMEDIATE");
       static constexpr auto EXPERT =
           GameBoardDraw::GenerateTileString("EXPERT");
+      static constexpr auto NO_GUESS =
+          GameBoardDraw::GenerateTileString("NO GUESS");
       static constexpr auto HOW_TO_PLAY =
           GameBoardDraw::GenerateTileString("HOW TO PLAY");
       static constexpr auto COPYRIGHT = GameBoardDraw::GenerateTileString("COPYRIGHT 2022 KEVIN ARUNSKI");
@@ -999,71 +2385,106 @@ std::uint8_t cursor_anim_frame = 0;
       GameBoardDraw::DrawString(BEGINNER, 5, 5);
       GameBoardDraw::DrawString(INTERMEDIATE, 5, 7);
       GameBoardDraw::DrawString(EXPERT, 5, 9);
-      GameBoardDraw::DrawString(HELP1, 1, target::graphics::ScreenHeight - 6);
-      GameBoardDraw::DrawString(HELP2, 1, target::graphics::ScreenHeight - 4);
+      GameBoardDraw::DrawString(NO_GUESS, 5, 11);
+      target::graphics::place_immediate(
+          no_guess ? target::graphics::Flag : target::graphics::BLANK,
+          NoGuessMarker.X, NoGuessMarker.Y);
+      GameBoardDraw::DrawString(HELP1, 1, target::graphics::ScreenHeight - 8);
+      GameBoardDraw::DrawString(HELP2, 1, target::graphics::ScreenHeight - 6);
+      GameBoardDraw::DrawString(HELP3, 1, target::graphics::ScreenHeight - 4);
       GameBoardDraw::DrawString(COPYRIGHT, 1, target::graphics::ScreenHeight - 2);
 
       target::graphics::render_on();
+
+      use_difficulty();
     }
 
     AppMode * on_vsync(FireButtonEventFilter::Event, key_scan_res) override;
 
     enum Difficulty : std::uint8_t {
-      BEGINNER = 0, INTERMEDIATE = 1, EXPERT = 2
+      BEGINNER = 0, INTERMEDIATE = 1, EXPERT = 2,
+      // not a difficulty: the menu line below them.
+      NO_GUESS_SWITCH = 3
     };
 
     static constexpr TilePoint DifficultyToSelectionArrow[] = {
       TilePoint{3, 5}, TilePoint{3, 7}, TilePoint{3, 9}
     };
+    static constexpr TilePoint NoGuessArrow{3, 11};
+    static constexpr TilePoint NoGuessMarker{14, 11};
+
+    // Set the board up for the selected difficulty.  In no-guess mode the
+    // search for its first board starts here, while the menu waits.
+    static void use_difficulty() {
+      GameBoardDraw::SetGameSize(DIFFICULTY_PRESETS[difficulty].m_rows,
+                                 DIFFICULTY_PRESETS[difficulty].m_columns);
+      mines = DIFFICULTY_PRESETS[difficulty].m_mines;
+      game_preset = difficulty;
+      if (no_guess) {
+        no_guess_generator.start(false);
+      }
+    }
 
     static Difficulty difficulty;
+    // the arrow is on the no-guess switch below the difficulties.
+    static bool no_guess_selected;
   };
 
   AppModeSelectDifficulty::Difficulty AppModeSelectDifficulty::difficulty = AppModeSelectDifficulty::BEGINNER;
+  bool AppModeSelectDifficulty::no_guess_selected = false;
 
   struct AppModeDead : public AppMode {
-    void on_init(AppMode *) override{}
+    void on_init(AppMode *) override {
+      game_state.time_running = false;
+      board_sweep.start();
+      game_state.job.start(Job::GAME_OVER_SWEEP);
+    }
     AppMode *on_vsync(FireButtonEventFilter::Event, key_scan_res) override;
   };
 
   struct AppModeWin : public AppMode {
-    void on_init(AppMode *) override {}
+    void on_init(AppMode *) override {
+      game_state.time_running = false;
+      board_sweep.start();
+      game_state.job.start(Job::WIN_SWEEP);
+
+      // 3BV/s in hundredths, timed to the frame the clock has counted up to.
+      const std::uint32_t frames =
+          std::uint32_t{game_state.timer} * clock_updater.frames_per_second +
+          clock_updater.current_frames;
+      const std::uint32_t hundredths =
+          frames == 0 ? RATE_MAX
+                      : std::uint32_t{game_state.bbbv} * 100 *
+                            clock_updater.frames_per_second / frames;
+      bbbv_rate = hundredths < RATE_MAX ? hundredths : RATE_MAX;
+      stats_drawn = false;
+    }
     AppMode *on_vsync(FireButtonEventFilter::Event, key_scan_res) override;
+
+    // 9.99 3BV/s, all DrawStats() has digits for.
+    static constexpr std::uint16_t RATE_MAX = 999;
+    static std::uint16_t bbbv_rate;
+    static bool stats_drawn;
   };
 
+  std::uint16_t AppModeWin::bbbv_rate = 0;
+  bool AppModeWin::stats_drawn = false;
+
   AppModeGame game_field;
 
   AppModeResetButton reset_selection;
   AppModeDead mode_dead;
   AppModeWin mode_win;
 
-  constexpr AppMode * next_mode_win[2] = { &game_field, &mode_win};
-
   bool AppModeGame::continue_expose_events() {
     // "expose" means we are figuring out which tiles need to be automatically
-    // opened up because there are no mines around them. Figuring out which
-    // ones are like this can take a long time, so we split the operation up
-    // into a sequence of function calls that expose only a few tiles per frame.
-    // Each of these function object pointers is stored in
-    // game_state.expose_continuation for the current frame.
-    if (!game_state.expose_continuation) {
+    // opened up because there are no mines around them. Drawing them all can
+    // take a long time, so it runs as a job that is resumed once per frame.
+    if (!game_state.job.running()) {
       return true;
     }
 
-    // avoid virtual function call to work-around lack of stack on NES.
-    // clang currently always requires the stack for that function call??
-    if (game_state.expose_continuation == &expose_must_continue) {
-      const auto expose_res =
-          expose_must_continue(); //(*game_state.expose_continuation)();
-      game_state.expose_continuation = expose_res.next_expose;
-      if (!expose_res.is_ok) {
-        return false;
-      }
-      suppress_expose = game_state.expose_continuation != nullptr;
-      return true;
-    }
-
-    return true;  
+    return game_state.job.resume() != Job::FAILED;
   }
 
   template<bool CanExpandSprite = target::graphics::CanExpandSprites>
@@ -1084,9 +2505,9 @@ std::uint8_t cursor_anim_frame = 0;
   AppModeGame::on_vsync(FireButtonEventFilter::Event fire_button_events,
                         key_scan_res direction_events) {
 
-    if (!continue_expose_events()) {
-      game_state.time_running = false;
-      return &mode_dead;
+    // the board takes no clicks until its no-guess board has been dealt.
+    if (game_state.job.kind == Job::GENERATE) {
+      fire_button_events = FireButtonEventFilter::NO_EVENT;
     }
 
     // on space bar released...
@@ -1096,19 +2517,39 @@ std::uint8_t cursor_anim_frame = 0;
         suppress_expose = false;
       }
       else {
-        const auto [is_ok, next_expose] = expose_recurse(current_selected, 0);
-        game_state.expose_continuation = next_expose;
+        // the release that ends a long press which planted a flag opens
+        // nothing, so it must not lay the board around that tile.
+        if (!game_state.mines_placed &&
+            !game_state.is_flagged(current_selected)) {
+          generate_board(current_selected);
+        }
+        // a click while an opening is still being revealed joins its move,
+        // as the tiles revealed from now on are those of both.
+        if (game_state.job.kind != Job::REVEAL) {
+          game_state.journal.begin_move();
+        }
+        const auto [is_ok, next_job] = expose_recurse(current_selected, 0);
 
         if (!is_ok) {
-          game_state.time_running = false;
+          mode_dead.on_init(this);
           return &mode_dead;
         }
+
+        // a new opening is merged into the frontier of any opening that is
+        // still being drawn, so the job just carries on with both.
+        if (next_job != Job::NONE) {
+          game_state.job.start(next_job);
+        }
       }
       GameBoardDraw::DrawResetButtonHappy();
       game_state.time_running = true;
       break;
     case FireButtonEventFilter::LONG_PRESS: {
       if (!game_state.is_exposed(current_selected)) {
+        if (game_state.job.kind != Job::REVEAL) {
+          game_state.journal.begin_move();
+        }
+        game_state.journal.flag(current_selected);
         if (game_state.set_flag(current_selected)) {
           target::music::play(0, false, target::sounds::flag_sfx);
           GameBoardDraw::Flag(current_selected);
@@ -1155,9 +2596,18 @@ std::uint8_t cursor_anim_frame = 0;
 
     score_updater();
 
-    const auto winning = game_state.hidden_clear == 0;
-    game_state.time_running = !winning;
-    return next_mode_win[winning];
+    // Done last, so revealing gets whatever drawing time the frame has left.
+    if (!continue_expose_events()) {
+      mode_dead.on_init(this);
+      return &mode_dead;
+    }
+
+    if (game_state.hidden_clear == 0) {
+      mode_win.on_init(this);
+      return &mode_win;
+    }
+
+    return this;
   }
 
   AppMode *
@@ -1166,14 +2616,30 @@ std::uint8_t cursor_anim_frame = 0;
     
     switch (fire_button_events) {
       case FireButtonEventFilter::RELEASE:
+        if (undo_held) {
+          // the undo job runs from the board.
+          undo_held = false;
+          GameBoardDraw::DrawResetButtonHappy();
+          game_field.on_init(this);
+          return &game_field;
+        }
         target::graphics::render_off();
         reset();
         target::graphics::render_on();
         break;
       case FireButtonEventFilter::PRESS:
+        // a long press of the B button has no release, so its undo_held
+        // can't outlive the next press.
+        undo_held = false;
         GameBoardDraw::DrawResetButtonCaution();
         break;
       case FireButtonEventFilter::LONG_PRESS:
+        // each long press while the game is on takes back one more move.
+        if (game_state.time_running) {
+          game_state.start_undo();
+          undo_held = true;
+        }
+        break;
       case FireButtonEventFilter::NO_EVENT:
         break;
     }
@@ -1183,12 +2649,14 @@ std::uint8_t cursor_anim_frame = 0;
     cursor_animator();
 
     if (direction_events.s) {
+      undo_held = false;
       AppModeGame::current_selected.Y = 0;
       game_field.on_init(this);
       return &game_field;
     }
 
     if (direction_events.w) {
+      undo_held = false;
       AppModeGame::current_selected.Y = game_rows - 1;
       game_field.on_init(this);
       return &game_field;
@@ -1201,27 +2669,16 @@ std::uint8_t cursor_anim_frame = 0;
       FireButtonEventFilter::Event fire_button_events,
       key_scan_res direction_events) {
 
-    struct DifficultySettings
-    {
-      std::uint8_t m_rows;
-      std::uint8_t m_columns;
-      std::uint8_t m_mines;
-
-      constexpr DifficultySettings(std::uint8_t rows, std::uint8_t columns,
-                                   std::uint8_t mines)
-          : m_rows{rows}, m_columns{columns}, m_mines{mines} {}
-    };
-
-    static constexpr DifficultySettings DIFFICULTY_PRESETS[] = {
-        {9, 9, 10}, {16,16,40}, {16,30,99}
-    };
-
     switch (fire_button_events) {
     case FireButtonEventFilter::RELEASE:
-      GameBoardDraw::SetGameSize(DIFFICULTY_PRESETS[difficulty].m_rows,
-                                 DIFFICULTY_PRESETS[difficulty].m_columns);
-      mines = DIFFICULTY_PRESETS[difficulty].m_mines;
-      reset();
+      if (no_guess_selected) {
+        no_guess = !no_guess;
+        target::graphics::place(
+            no_guess ? target::graphics::Flag : target::graphics::BLANK,
+            NoGuessMarker);
+        use_difficulty();
+        break;
+      }
       target::graphics::render_off();
       game_field.on_init(this);
       target::graphics::render_on();
@@ -1233,7 +2690,8 @@ std::uint8_t cursor_anim_frame = 0;
       break;
     }
 
-    switch (difficulty)
+    const Difficulty last_difficulty = difficulty;
+    switch (no_guess_selected ? NO_GUESS_SWITCH : difficulty)
     {
       case BEGINNER:
         difficulty = direction_events.s ? INTERMEDIATE : BEGINNER;
@@ -1245,7 +2703,15 @@ std::uint8_t cursor_anim_frame = 0;
         break;
       case EXPERT:
         difficulty = direction_events.w ? INTERMEDIATE : EXPERT;
+        no_guess_selected = direction_events.s;
         break;
+      case NO_GUESS_SWITCH:
+        no_guess_selected = !direction_events.w;
+        break;
+    }
+
+    if (difficulty != last_difficulty) {
+      use_difficulty();
     }
     
     target::graphics::place(target::graphics::BLANK, DifficultyToSelectionArrow[BEGINNER]);
@@ -1253,8 +2719,16 @@ std::uint8_t cursor_anim_frame = 0;
                                    DifficultyToSelectionArrow[INTERMEDIATE]);
     target::graphics::place(target::graphics::BLANK,
                                    DifficultyToSelectionArrow[EXPERT]);
+    target::graphics::place(target::graphics::BLANK, NoGuessArrow);
     target::graphics::place(target::graphics::SelectArrow,
-                                   DifficultyToSelectionArrow[difficulty]);
+                            no_guess_selected
+                                ? NoGuessArrow
+                                : DifficultyToSelectionArrow[difficulty]);
+
+    // look for a no-guess board in the time the menu leaves.
+    if (no_guess && game_state.job.kind == Job::GENERATE) {
+      game_state.job.resume();
+    }
     return this;
   }
 
@@ -1295,6 +2769,9 @@ std::uint8_t cursor_anim_frame = 0;
 
     cursor_animator();
 
+    // uncover the rest of the board with whatever drawing time is left.
+    game_state.job.resume();
+
     return this;
   }
 
@@ -1317,6 +2794,17 @@ std::uint8_t cursor_anim_frame = 0;
 
     cursor_animator();
 
+    score_updater();
+
+    if (!stats_drawn &&
+        target::graphics::place_budget() >= GameBoardDraw::StatsTiles) {
+      GameBoardDraw::DrawStats(game_state.bbbv, bbbv_rate);
+      stats_drawn = true;
+    }
+
+    // flag the remaining mines with whatever drawing time is left.
+    game_state.job.resume();
+
     return this;
   }
 
@@ -1364,11 +2852,11 @@ int main()
     static key_scan_res keys;
     keys = target::check_keys();
 
+    game_state.time_running && clock_updater();
+
     current_mode = current_mode->on_vsync(fire_button_handler(keys),
                                           direction_event_filter(keys));
 
-    game_state.time_running && clock_updater();
-
     target::music::update();
   }
 
@@ -2,18 +2,40 @@
 
 namespace {
 
-unsigned rand_state = 1;
+// xorshift32 with the full-period shift triple (8, 9, 23): shifts of 8 and
+// 9 are a byte move (plus one bit), and 23 is three byte moves and one bit
+// back, so the 6502 never loops over single bit shifts.  Period 2^32 - 1.
+std::uint32_t rand_state = 1;
 
 }
 
 void srand(unsigned seed) {
-  rand_state = seed;
+  // the state must never be all zero.
+  rand_state = (std::uint32_t{seed} << 16) | 1;
 }
 
 int rand() {
 
-  rand_state ^= rand_state << 7;
-  rand_state ^= rand_state >> 9;
   rand_state ^= rand_state << 8;
-  return static_cast<int>(rand_state);
+  rand_state ^= rand_state >> 9;
+  rand_state ^= rand_state << 23;
+  return static_cast<int>(rand_state >> 16);
+}
+
+std::uint32_t rand_save() {
+  return rand_state;
+}
+
+void rand_restore(std::uint32_t state) {
+  rand_state = state;
+}
+
+// floor(r * n / 2^24) for 24 random bits r, split so that every product
+// fits in 32 bits.  The bias is below n / 2^24.
+std::uint16_t rand_range(std::uint16_t n) {
+  rand();
+  const auto high = static_cast<std::uint16_t>(rand_state >> 16);
+  const auto low = static_cast<std::uint8_t>(rand_state >> 8);
+  return static_cast<std::uint16_t>(
+      (std::uint32_t{high} * n + ((std::uint32_t{low} * n) >> 8)) >> 16);
 }
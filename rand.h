@@ -1,7 +1,17 @@
 #ifndef NONSTD_RAND_H
 #define NONSTD_RAND_H
 
+#include <cstdint>
+
 void srand(unsigned);
 int rand();
 
+// The whole generator state, to replay a sequence from where it was saved.
+std::uint32_t rand_save();
+void rand_restore(std::uint32_t state);
+
+// A random number in [0, n), scaled by a multiply rather than reduced by
+// a division.
+std::uint16_t rand_range(std::uint16_t n);
+
 #endif
@@ -128,6 +128,26 @@ struct target {
       place(Tile, x, y);
     }
 
+    // Number of tiles that can still be drawn before the next frame starts.
+    // Tiles go straight to screen ram, so the limit is the raster time left
+    // in this frame, keeping some lines back for the rest of the frame's
+    // work.  The 16 raster lines (about 1000 cycles) per tile is an
+    // estimate, not measured.
+    static std::uint8_t place_budget() {
+      static constexpr std::uint8_t RasterLinesPerTileShift = 4;
+      static constexpr std::uint8_t ReservedRasterLines = 16;
+
+      const auto raster = c64::vic_ii.get_raster();
+      if (raster + ReservedRasterLines >= frame_raster_lines) {
+        return 0;
+      }
+
+      return (frame_raster_lines - ReservedRasterLines - raster) >>
+             RasterLinesPerTileShift;
+    }
+
+    static std::uint16_t frame_raster_lines;
+
     struct tile_to_char {
       static constexpr auto call(char c) {
         return c == ' '
@@ -160,6 +180,21 @@ struct target {
       place(Tile, tilePos.X, tilePos.Y);
     }
 
+    // Where a tile lives: its offset into screen ram, which is also its
+    // offset into color ram.  Worked out once per row with a multiply, so
+    // drawing along the row is just an add.
+    using tile_address = std::uint16_t;
+
+    static tile_address address_of(std::uint8_t x, std::uint8_t y) {
+      return y * ScreenWidth + x;
+    }
+
+    static void place(ScreenCode Tile, tile_address address) {
+      c64::screen_ram.data()[address] = Tile;
+      c64::color_ram.data()[address] =
+          minesweeper_color[static_cast<uint8_t>(Tile)];
+    }
+
     struct Palettes {
       color_type background_color;
     };
@@ -249,7 +284,8 @@ struct target {
   }
 
   static std::uint8_t frames_per_second() {
-    return count_raster() > 263 ? 50 : 60;
+    graphics::frame_raster_lines = count_raster() + 1;
+    return graphics::frame_raster_lines > 264 ? 50 : 60;
   }
 
   static void load_tile_set() {
@@ -370,6 +406,8 @@ private:
   }
 };
 
+inline std::uint16_t target::graphics::frame_raster_lines = 263;
+
 inline const target::graphics::sprite_pattern target::graphics::Cursor{
     0, 7, minesweeper_cursor[0].mode.sprite_color()};
 
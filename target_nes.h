@@ -5,6 +5,8 @@
 
 #include "tile_model.h"
 #include "input_model.h"
+#include "zero_page.h"
+#include "lookup_tables.h"
 
 #include <cstdint>
 #include <nes.h>
@@ -180,6 +182,11 @@ namespace nes {
 
     static_assert(sizeof(palette_atlas) == sizeof(chr_code_atlas) / 4);
 
+    // tile_to_palette_idx() of every tile, unpacked from palette_atlas at
+    // compile time.
+    static const lut::Table<std::uint8_t, sizeof(palette_atlas) * 4>
+        palette_of_tile;
+
     static constexpr tile_type BLANK{0};
     static constexpr tile_type BLANK_BORDER{85};
     static constexpr tile_type LetterA{0x04};
@@ -333,9 +340,8 @@ namespace nes {
 
     static constexpr std::uint8_t attr_byte_mask(std::uint8_t attr_x,
                                                  std::uint8_t attr_y) {
-      constexpr std::uint8_t mask_bits[2][2] = {{0b00000011, 0b00001100},
-                                                {0b00110000, 0b11000000}};
-      return mask_bits[attr_y & 0b1][attr_x & 0b1];
+      return std::to_integer<std::uint8_t>(
+          lut::pair_mask[((attr_y & 0b1) << 1) | (attr_x & 0b1)]);
     }
 
     struct attr_point {
@@ -349,9 +355,13 @@ namespace nes {
         return (y >> 1) * 8 + (x >> 1);
       }
 
+      // which of the 4 2-bit fields of the attribute byte is ours.
+      constexpr std::uint8_t attr_byte_field() const {
+        return ((y & 0b1) << 1) | (x & 0b1);
+      }
+
       constexpr std::uint8_t attr_byte_shift() const {
-        constexpr std::uint8_t shift_amt[2][2] = {{0, 2}, {4, 6}};
-        return shift_amt[y & 0b1][x & 0b1];
+        return lut::pair_shift[attr_byte_field()];
       }
     };
 
@@ -366,6 +376,18 @@ namespace nes {
     }
 
     static void place(tile_type tile, const TilePoint &location) {
+      place(tile, address_of(location.X, location.Y));
+    }
+
+    // Where a tile lives: its nametable offset.  Worked out once per row,
+    // so drawing along the row is just an add.
+    using tile_address = std::uint16_t;
+
+    static tile_address address_of(std::uint8_t x, std::uint8_t y) {
+      return y * 32 + x;
+    }
+
+    static void place(tile_type tile, tile_address address) {
       if (tile_updates_size == TILE_UPDATES_MAX) {
         return;
       }
@@ -373,11 +395,20 @@ namespace nes {
       {
         auto &current_update = tile_updates[tile_updates_size];
         current_update.tile = tile_to_chr_code(tile);
-        current_update.nametable_offset = location.Y * 32 + location.X;
+        current_update.nametable_offset = address;
         tile_updates_size += 1;
       }
     }
 
+    // Number of tiles that can still be queued with place() this frame.  The
+    // update queue is sized to what finish_rendering() can push to the PPU
+    // during vblank, so the free space in the queue is the whole budget.
+    // The CPU time to produce that many reveals is taken to fit in the rest
+    // of the frame; that is an estimate, not measured.
+    static std::uint8_t place_budget() {
+      return TILE_UPDATES_MAX - tile_updates_size;
+    }
+
     static void update_attr(std::uint8_t attr_offset, std::byte mask,
                             std::byte attr_data) {
       const auto attr_byte_ptr =
@@ -390,10 +421,11 @@ namespace nes {
     static void place_attr_immediate(tile_type tile, std::uint8_t x,
                                      std::uint8_t y) {
       const auto location_attr = tile_point_to_attr_point(TilePoint{x, y});
-      const auto shift = location_attr.attr_byte_shift();
+      const auto field = location_attr.attr_byte_field();
 
-      update_attr(location_attr.attr_table_offset(), std::byte{0b11} << shift,
-                  std::byte{tile_to_palette_idx(tile)} << shift);
+      update_attr(location_attr.attr_table_offset(), lut::pair_mask[field],
+                  std::byte{palette_of_tile[static_cast<std::uint8_t>(tile)]}
+                      << lut::pair_shift[field]);
     }
 
     static void place_immediate(tile_type tile, std::uint8_t x,
@@ -795,12 +827,23 @@ namespace nes {
     }
   }
 
+  inline constexpr lut::Table<std::uint8_t,
+                              sizeof(target::graphics::palette_atlas) * 4>
+      target::graphics::palette_of_tile =
+          lut::make_table<std::uint8_t,
+                          sizeof(target::graphics::palette_atlas) * 4>(
+              [](std::uint8_t tile) {
+                return target::graphics::tile_to_palette_idx(
+                    target::graphics::tile_type{tile});
+              });
+
   inline std::uint8_t target::graphics::tile_string_updates_size = 0;
   inline target::graphics::TileStringUpdate target::graphics::
       tile_string_updates[target::graphics::TILE_STRING_UPDATES_MAX];
 
-  inline std::uint8_t target::graphics::tile_updates_size = 0;
-  inline target::graphics::TileUpdate
+  // queued and flushed for every tile drawn, the flush inside vblank.
+  ZP_BSS inline std::uint8_t target::graphics::tile_updates_size = 0;
+  ZP_BSS inline target::graphics::TileUpdate
       target::graphics::tile_updates[target::graphics::TILE_UPDATES_MAX];
 
   inline const target::graphics::Palettes *target::graphics::next_palettes =
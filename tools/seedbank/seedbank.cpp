@@ -0,0 +1,343 @@
+// Build-time generator of no-guess boards for the game's seed bank.
+//
+//   seedbank OUTPUT SEED MAX_BOARDS [NAME ROWS COLUMNS MINES BUDGET]...
+//
+// For each preset, deals random boards with the first tile in the middle
+// of the board and its neighbours clear, the same as the game's no-guess
+// mode, and keeps those its solver can finish from that tile by deduction
+// alone.  Boards are kept until MAX_BOARDS or until the next one would not
+// fit in BUDGET bytes of ROM, and are written to OUTPUT as a C++ header.
+//
+// A board is stored as its mine indexes (row-major), each as the gap of
+// cells skipped since the previous mine, a nibble at a time, low nibble
+// first: nibbles 0-14 end a gap, 15 adds 15 and carries on.  Every board
+// starts on a byte, found through a table of 16-bit offsets.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Preset {
+  std::string name;
+  int rows;
+  int columns;
+  int mines;
+  long budget;
+};
+
+// A board and what a player could know of it.
+class Board {
+public:
+  Board(const Preset & preset, std::mt19937 & random)
+      : m_rows{preset.rows}, m_columns{preset.columns},
+        m_mine(preset.rows * preset.columns), m_count(m_mine.size()) {
+    const int first_x = m_columns / 2;
+    const int first_y = m_rows / 2;
+
+    std::vector<int> cells;
+    for (int y = 0; y < m_rows; ++y) {
+      for (int x = 0; x < m_columns; ++x) {
+        if (std::abs(x - first_x) > 1 || std::abs(y - first_y) > 1) {
+          cells.push_back(y * m_columns + x);
+        }
+      }
+    }
+    // a partial shuffle picks the mines.
+    for (int i = 0; i < preset.mines; ++i) {
+      std::uniform_int_distribution<int> pick(i, cells.size() - 1);
+      std::swap(cells[i], cells[pick(random)]);
+      m_mine[cells[i]] = true;
+    }
+
+    for (int y = 0; y < m_rows; ++y) {
+      for (int x = 0; x < m_columns; ++x) {
+        for_around(x, y, [&](int index) { m_count[y * m_columns + x] += m_mine[index]; });
+      }
+    }
+
+    m_first = first_y * m_columns + first_x;
+  }
+
+  // Play from the first tile with the rules the game's solver uses: a
+  // tile's count met by known mines, or needing all its unknown
+  // neighbours; then, when stuck, a tile whose unknown neighbours are a
+  // subset of a tile up to 2 away.  True if every safe tile gets revealed.
+  bool solvable() {
+    m_known.assign(m_mine.size(), UNKNOWN);
+    m_known[m_first] = SAFE;
+
+    for (bool subsets = false;;) {
+      bool progress = false;
+      for (int index = 0; index < static_cast<int>(m_known.size()); ++index) {
+        if (m_known[index] == SAFE && visit(index, subsets)) {
+          progress = true;
+        }
+      }
+
+      if (progress) {
+        subsets = false;
+      } else if (!subsets) {
+        subsets = true;
+      } else {
+        break;
+      }
+    }
+
+    for (std::size_t index = 0; index < m_known.size(); ++index) {
+      if (!m_mine[index] && m_known[index] != SAFE) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<std::uint8_t> encode() const {
+    std::vector<std::uint8_t> nibbles;
+    int gap = 0;
+    for (std::size_t index = 0; index < m_mine.size(); ++index) {
+      if (!m_mine[index]) {
+        gap += 1;
+        continue;
+      }
+      for (; gap >= 15; gap -= 15) {
+        nibbles.push_back(15);
+      }
+      nibbles.push_back(gap);
+      gap = 0;
+    }
+
+    std::vector<std::uint8_t> bytes((nibbles.size() + 1) / 2);
+    for (std::size_t i = 0; i < nibbles.size(); ++i) {
+      bytes[i / 2] |= nibbles[i] << ((i & 1) * 4);
+    }
+    return bytes;
+  }
+
+private:
+  enum Knowledge : std::uint8_t { UNKNOWN, SAFE, MINE };
+
+  template <class Function> void for_around(int x, int y, Function function) const {
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        const int nx = x + dx;
+        const int ny = y + dy;
+        if ((dx || dy) && nx >= 0 && ny >= 0 && nx < m_columns && ny < m_rows) {
+          function(ny * m_columns + nx);
+        }
+      }
+    }
+  }
+
+  // the unknown neighbours of a tile, and the mines it still needs there.
+  std::vector<int> unknowns(int index, int & needed) const {
+    std::vector<int> result;
+    needed = m_count[index];
+    for_around(index % m_columns, index / m_columns, [&](int other) {
+      if (m_known[other] == UNKNOWN) {
+        result.push_back(other);
+      } else if (m_known[other] == MINE) {
+        needed -= 1;
+      }
+    });
+    return result;
+  }
+
+  static bool contains(const std::vector<int> & set, int index) {
+    for (int member : set) {
+      if (member == index) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool learn(const std::vector<int> & tiles, Knowledge knowledge) {
+    for (int tile : tiles) {
+      m_known[tile] = knowledge;
+    }
+    return !tiles.empty();
+  }
+
+  bool visit(int index, bool subsets) {
+    int needed;
+    const auto unknown = unknowns(index, needed);
+    if (unknown.empty()) {
+      return false;
+    }
+    if (needed == 0) {
+      return learn(unknown, SAFE);
+    }
+    if (needed == static_cast<int>(unknown.size())) {
+      return learn(unknown, MINE);
+    }
+    if (!subsets) {
+      return false;
+    }
+
+    const int x = index % m_columns;
+    const int y = index / m_columns;
+    for (int dy = -2; dy <= 2; ++dy) {
+      for (int dx = -2; dx <= 2; ++dx) {
+        const int ox = x + dx;
+        const int oy = y + dy;
+        if ((!dx && !dy) || ox < 0 || oy < 0 || ox >= m_columns || oy >= m_rows ||
+            m_known[oy * m_columns + ox] != SAFE) {
+          continue;
+        }
+
+        int other_needed;
+        const auto other_unknown = unknowns(oy * m_columns + ox, other_needed);
+        bool subset = true;
+        for (int tile : unknown) {
+          subset = subset && contains(other_unknown, tile);
+        }
+        if (!subset) {
+          continue;
+        }
+
+        std::vector<int> rest;
+        for (int tile : other_unknown) {
+          if (!contains(unknown, tile)) {
+            rest.push_back(tile);
+          }
+        }
+        if (rest.empty()) {
+          continue;
+        }
+
+        if (other_needed == needed) {
+          return learn(rest, SAFE);
+        }
+        if (other_needed - needed == static_cast<int>(rest.size())) {
+          return learn(rest, MINE);
+        }
+      }
+    }
+    return false;
+  }
+
+  int m_rows;
+  int m_columns;
+  int m_first;
+  std::vector<bool> m_mine;
+  std::vector<std::uint8_t> m_count;
+  std::vector<Knowledge> m_known;
+};
+
+void write_bytes(std::FILE * out, const std::vector<std::uint8_t> & bytes) {
+  for (std::size_t i = 0; i < bytes.size(); ++i) {
+    std::fprintf(out, "%s0x%02x,", i % 16 ? " " : "\n    ", bytes[i]);
+  }
+  if (bytes.empty()) {
+    std::fprintf(out, "\n    0,");
+  }
+  std::fprintf(out, "\n");
+}
+
+} // namespace
+
+int main(int argc, char ** argv) {
+  if (argc < 4 || (argc - 4) % 5 != 0) {
+    std::fprintf(stderr, "usage: seedbank OUTPUT SEED MAX_BOARDS "
+                         "[NAME ROWS COLUMNS MINES BUDGET]...\n");
+    return 1;
+  }
+
+  std::mt19937 random(std::strtoul(argv[2], nullptr, 0));
+  const long max_boards = std::strtol(argv[3], nullptr, 0);
+
+  std::vector<Preset> presets;
+  for (int arg = 4; arg < argc; arg += 5) {
+    presets.push_back(Preset{argv[arg], std::atoi(argv[arg + 1]),
+                             std::atoi(argv[arg + 2]), std::atoi(argv[arg + 3]),
+                             std::strtol(argv[arg + 4], nullptr, 0)});
+  }
+
+  std::FILE * out = std::fopen(argv[1], "w");
+  if (!out) {
+    std::perror(argv[1]);
+    return 1;
+  }
+
+  std::fprintf(out, "// Generated by tools/seedbank; do not edit.\n\n"
+                    "#ifndef SEED_BANK_H\n"
+                    "#define SEED_BANK_H\n\n"
+                    "#include <cstdint>\n\n");
+  std::vector<long> counts;
+
+  for (const auto & preset : presets) {
+    std::vector<std::uint8_t> data;
+    std::vector<std::uint16_t> offsets;
+    long dealt = 0;
+
+    while (static_cast<long>(offsets.size()) < max_boards) {
+      Board board(preset, random);
+      dealt += 1;
+      if (!board.solvable()) {
+        continue;
+      }
+
+      const auto bytes = board.encode();
+      const long size = data.size() + bytes.size() + 2 * (offsets.size() + 1);
+      if (size > preset.budget || data.size() > 0xFFFF) {
+        break;
+      }
+      offsets.push_back(data.size());
+      data.insert(data.end(), bytes.begin(), bytes.end());
+    }
+
+    const long bytes = data.size() + 2 * offsets.size();
+    std::printf("seedbank: %s: %zu boards in %ld bytes", preset.name.c_str(),
+                offsets.size(), bytes);
+    if (!offsets.empty()) {
+      std::printf(", %.1f bytes per board, 1 in %.1f boards dealt had no guesses",
+                  static_cast<double>(bytes) / offsets.size(),
+                  static_cast<double>(dealt) / offsets.size());
+    }
+    std::printf("\n");
+
+    std::fprintf(out, "// %s: %zu boards, %ld bytes\n", preset.name.c_str(),
+                 offsets.size(), bytes);
+    std::fprintf(out, "inline constexpr std::uint8_t SEED_BANK_%s[] = {",
+                 preset.name.c_str());
+    write_bytes(out, data);
+    std::fprintf(out, "};\n");
+    std::fprintf(out, "inline constexpr std::uint16_t SEED_BANK_%s_OFFSETS[] = {",
+                 preset.name.c_str());
+    for (std::size_t i = 0; i < offsets.size(); ++i) {
+      std::fprintf(out, "%s%u,", i % 8 ? " " : "\n    ", offsets[i]);
+    }
+    std::fprintf(out, "%s\n};\n\n", offsets.empty() ? "\n    0," : "");
+    counts.push_back(offsets.size());
+  }
+
+  // the presets the boards were dealt for, to check against the game's.
+  std::fprintf(out, "inline constexpr std::uint8_t SEED_BANK_PRESETS[][3] = {");
+  for (std::size_t i = 0; i < presets.size(); ++i) {
+    std::fprintf(out, "%s{%d, %d, %d}", i ? ", " : "", presets[i].rows,
+                 presets[i].columns, presets[i].mines);
+  }
+  std::fprintf(out, "};\n");
+  std::fprintf(out, "inline constexpr std::uint16_t SEED_BANK_BOARDS[] = {");
+  for (std::size_t i = 0; i < presets.size(); ++i) {
+    std::fprintf(out, "%s%ld", i ? ", " : "", counts[i]);
+  }
+  std::fprintf(out, "};\n");
+  std::fprintf(out, "inline constexpr const std::uint8_t * SEED_BANK_DATA[] = {");
+  for (std::size_t i = 0; i < presets.size(); ++i) {
+    std::fprintf(out, "%sSEED_BANK_%s", i ? ", " : "", presets[i].name.c_str());
+  }
+  std::fprintf(out, "};\n");
+  std::fprintf(out, "inline constexpr const std::uint16_t * SEED_BANK_OFFSETS[] = {");
+  for (std::size_t i = 0; i < presets.size(); ++i) {
+    std::fprintf(out, "%sSEED_BANK_%s_OFFSETS", i ? ", " : "", presets[i].name.c_str());
+  }
+  std::fprintf(out, "};\n\n#endif\n");
+
+  return std::fclose(out) == 0 ? 0 : 1;
+}
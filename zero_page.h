@@ -0,0 +1,14 @@
+#pragma once
+
+#ifndef MINESWEEPER_ZERO_PAGE_H
+#define MINESWEEPER_ZERO_PAGE_H
+
+// Put a zero-initialised variable in the 6502 zero page.  llvm-mos treats
+// anything in a .zp section as a zero page address, so accesses to it use
+// the shorter and faster zero page instructions; the platform linker scripts
+// collect .zp.bss after the imaginary registers.  Zero page is small, so
+// keep this for state touched every frame or every revealed tile; the build
+// prints how much of it each target has left.
+#define ZP_BSS __attribute__((section(".zp.bss")))
+
+#endif